@@ -0,0 +1,30 @@
+#include <Telemetry.hpp>
+
+// The record of the last report is kept at the end of the EEPROM
+const uint16_t TELEMETRY_ADDRESS = E2END + 1 - Telemetry::RECORD_SIZE;
+
+void setup() {
+    Serial.begin(9600);
+
+    // Instead of sending the full summary on every boot, only the changes of the signature row and the fuses since
+    // the last acknowledged report are reported. If nothing changed, the report is only two bytes long.
+    uint8_t report[Telemetry::MAX_REPORT_SIZE];
+    uint8_t size = Telemetry::report(report, TELEMETRY_ADDRESS);
+
+    Serial.print("Report: ");
+    for (uint8_t i = 0; i < size; i++) {
+        if (report[i] < 16) {
+            Serial.print('0');
+        }
+        Serial.print(report[i], HEX);
+        Serial.print(' ');
+    }
+    Serial.println();
+    Serial.flush();
+
+    // Store the reported state once the report is delivered. A real link would wait for the receiver to confirm it,
+    // otherwise the changes are reported again on the next boot. The EEPROM is written only when something changed.
+    Telemetry::acknowledge(TELEMETRY_ADDRESS);
+}
+
+void loop() {}
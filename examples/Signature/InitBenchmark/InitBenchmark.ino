@@ -0,0 +1,69 @@
+#include <Signature.hpp>
+
+// Measures the cost of reading the signature row. Without SIGNATURE_EAGER_INIT the first call of a getter pays for
+// reading the signature row, every further call only for the initialisation check. With SIGNATURE_EAGER_INIT defined
+// for the whole build (e.g. "build_flags = -DSIGNATURE_EAGER_INIT" in PlatformIO), the signature row is read before
+// main() and the first call costs the same as every other call. The boot-time cost is the same as the cost of
+// SignatureInfo::read().
+
+#if defined(TCNT1)
+volatile uint8_t sink; // Keeps the compiler from removing the measured calls
+
+uint16_t measureGetInfo() {
+    uint8_t sreg = SREG;
+    cli();
+    TCNT1 = 0;
+    sink = Signature::getInfo().getSignatureByte3();
+    uint16_t cycles = TCNT1;
+    SREG = sreg;
+    return cycles;
+}
+
+uint16_t measureRead() {
+    uint8_t sreg = SREG;
+    cli();
+    TCNT1 = 0;
+    sink = SignatureInfo::read().getSignatureByte3();
+    uint16_t cycles = TCNT1;
+    SREG = sreg;
+    return cycles;
+}
+#endif
+
+void setup() {
+    Serial.begin(9600);
+
+#if defined(TCNT1)
+    // Let Timer1 count CPU cycles
+    uint8_t tccr1a = TCCR1A;
+    uint8_t tccr1b = TCCR1B;
+    TCCR1A = 0;
+    TCCR1B = _BV(CS10);
+
+    uint16_t firstCall = measureGetInfo();
+    uint16_t secondCall = measureGetInfo();
+    uint16_t read = measureRead();
+
+    TCCR1A = tccr1a;
+    TCCR1B = tccr1b;
+
+#if defined(SIGNATURE_EAGER_INIT)
+    Serial.println("Mode: eager (signature row read before main())");
+#else
+    Serial.println("Mode: lazy (signature row read on first call)");
+#endif
+    Serial.print("First call of getInfo(): ");
+    Serial.print(firstCall);
+    Serial.println(" cycles");
+    Serial.print("Further call of getInfo(): ");
+    Serial.print(secondCall);
+    Serial.println(" cycles");
+    Serial.print("Reading the signature row (boot-time cost): ");
+    Serial.print(read);
+    Serial.println(" cycles");
+#else
+    Serial.println("The benchmark needs Timer1.");
+#endif
+}
+
+void loop() {}
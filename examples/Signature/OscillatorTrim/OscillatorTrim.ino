@@ -0,0 +1,32 @@
+#include <OscillatorTrim.hpp>
+
+void setup() {
+    Serial.begin(9600);
+
+#if defined(FEATURE_OSCILLATOR_TRIM)
+    // The ATtiny828 stores factory values for its temperature sensor in the signature row. They are used to measure
+    // the temperature and to correct the calibration of the internal 8MHz oscillator (OSCCAL0) when it drifts.
+    // Here OSCCAL0 is lowered by 4 steps per 16°C above 25°C (and raised below), which has to be characterised for
+    // the application. The temperature is sampled every 10 seconds.
+    OscillatorTrim::begin(-4, 10000);
+#else
+    Serial.println("The oscillator trimming is not available on this microcontroller.");
+#endif
+}
+
+void loop() {
+#if defined(FEATURE_OSCILLATOR_TRIM)
+    // Every call does only one small step and never waits for the ADC, so it can also be called from a timer
+    // interrupt.
+    OscillatorTrim::update(millis());
+
+    static unsigned long lastPrint = 0;
+    if (millis() - lastPrint >= 1000) {
+        lastPrint = millis();
+        Serial.print("Temperature: ");
+        Serial.print(OscillatorTrim::getTemperature());
+        Serial.print(" C; OSCCAL0: ");
+        Serial.println(OSCCAL0);
+    }
+#endif
+}
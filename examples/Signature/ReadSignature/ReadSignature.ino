@@ -14,18 +14,24 @@ void setup() {
     Serial.print("Chip Name: ");
     Serial.println(Signature::getChipName());
 
-#if defined(__AVR_ATmega48A__) || defined(__AVR_ATmega48PA__) ||       \
-        defined(__AVR_ATmega88A__) || defined(__AVR_ATmega88PA__) ||   \
-        defined(__AVR_ATmega168A__) || defined(__AVR_ATmega168PA__) || \
-        defined(__AVR_ATmega328__) || defined(__AVR_ATmega328P__)
     // In the Signature of the microcontrollers are also values which can be used for calibrating internal processes
-    // of the chip. For example for calibration the Internal RC Oscillator by software, you can use this value
-    Serial.print("RC Oscillator Calibration: ");
-    Serial.print(Signature::getRcOscillatorCalibration()); // Prints the value as a decimal value
-    Serial.print(" (decimal); ");
-    Serial.print(Signature::getRcOscillatorCalibration(), HEX); // Prints the value as a hex value
-    Serial.println(" (hex)");
-#endif
+    // of the chip. For example for calibration the Internal RC Oscillator by software, you can use this value.
+    // Which values exist depends on the microcontroller. has<Feature>() is known at compile time, so this branch is
+    // removed completely on microcontrollers without the value, and getOr<Feature>() compiles on every microcontroller.
+    if (Signature::has<Feature::RcOscillatorCalibration>()) {
+        uint8_t calibration = Signature::getOr<Feature::RcOscillatorCalibration>(0);
+        Serial.print("RC Oscillator Calibration: ");
+        Serial.print(calibration); // Prints the value as a decimal value
+        Serial.print(" (decimal); ");
+        Serial.print(calibration, HEX); // Prints the value as a hex value
+        Serial.println(" (hex)");
+    }
+
+    // All values can also be captured once as a small snapshot, which can be stored, compared or sent without any
+    // further access to the signature row.
+    SignatureInfo info = Signature::getInfo();
+    Serial.print("Signature Hash: ");
+    Serial.println(info.hash(), HEX);
 
     // To get a summary of your chip and the Signature, you can use the getSummary() method
     Serial.println(Signature::getSummary());
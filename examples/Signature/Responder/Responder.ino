@@ -0,0 +1,21 @@
+#include <Responder.hpp>
+
+// A bus master can query the signature of this node without disturbing the sketch: the answers are sent directly
+// from the UART interrupts. Send 0x01 for the signature, 0x02 for the full record or 0x10 + n for calibration byte
+// n. Every answer starts with its length. Serial must not be used, because the responder owns the USART0 interrupts.
+// The UART connects one node to the master; to query several nodes on one bus, use the TWI (Responder::beginTwi()).
+
+#if defined(USART_RX_vect) && defined(UDR0)
+SIGNATURE_RESPONDER_UART_ISR()
+#endif
+
+void setup() {
+#if defined(USART_RX_vect) && defined(UDR0)
+    Responder::begin();
+    Responder::beginUart(F_CPU / 16 / 9600 - 1); // 9600 baud
+#endif
+}
+
+void loop() {
+    // The sketch keeps running undisturbed
+}
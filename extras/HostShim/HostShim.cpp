@@ -0,0 +1,56 @@
+/*!
+ * @file HostShim.cpp
+ *
+ * This file is part of the Signature library. It gives easy access to the
+ * signature of AVR microcontrollers. The library contains functions that
+ * provides the information of the signature bytes.
+ *
+ * Copyright (C) 2022-2023  Niklas Kaaf
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ * USA
+ */
+
+#include "HostShim.hpp"
+
+#include <string.h>
+
+namespace HostShim {
+uint8_t signatureRow[SIGNATURE_ROW_SIZE];
+uint8_t fuses[4];
+
+uint8_t eeprom[EEPROM_SIZE];
+uint16_t eepromWrites;
+int16_t eepromWriteLimit;
+
+volatile uint8_t admuxa;
+volatile uint8_t admuxb;
+volatile uint8_t adcsra;
+volatile uint16_t adc;
+volatile uint8_t osccal0;
+
+void reset() {
+  memset(signatureRow, 0, sizeof(signatureRow));
+  memset(fuses, 0, sizeof(fuses));
+  memset(eeprom, 0xFF, sizeof(eeprom));
+  eepromWrites = 0;
+  eepromWriteLimit = -1;
+  admuxa = 0;
+  admuxb = 0;
+  adcsra = 0;
+  adc = 0;
+  osccal0 = 0;
+}
+} // namespace HostShim
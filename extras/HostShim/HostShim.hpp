@@ -0,0 +1,73 @@
+/*!
+ * @file HostShim.hpp
+ *
+ * This file is part of the Signature library. It gives easy access to the
+ * signature of AVR microcontrollers. The library contains functions that
+ * provides the information of the signature bytes.
+ *
+ * Copyright (C) 2022-2023  Niklas Kaaf
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ * USA
+ */
+
+/*
+ * Stand-ins for the parts of avr-libc used by the library, so that the
+ * sources in src/ can be compiled and tested on the host. The include
+ * directory is this one (-I extras/HostShim), the target is selected as for
+ * avr-gcc (e.g. -D__AVR_ATtiny828__) and HostShim.cpp has to be linked.
+ *
+ * Registers, the signature row and the fuses are plain variables, which a
+ * test sets up and inspects. Nothing of the hardware is simulated: e.g. a
+ * test has to clear ADSC itself to finish an ADC conversion.
+ */
+
+#ifndef SIGNATURE_HOST_SHIM_HPP
+#define SIGNATURE_HOST_SHIM_HPP
+
+#include <stdint.h>
+
+namespace HostShim {
+/** Size of the signature row (read by boot_signature_byte_get()). */
+const uint8_t SIGNATURE_ROW_SIZE = 0x40;
+
+/** Size of the EEPROM (largest of the devices). */
+const uint16_t EEPROM_SIZE = 4096;
+
+extern uint8_t signatureRow[SIGNATURE_ROW_SIZE]; /// Signature row.
+extern uint8_t fuses[4]; /// Fuses and lock bits, by GET_*_BITS address.
+
+extern uint8_t eeprom[EEPROM_SIZE]; /// EEPROM, erased to 0xFF by reset().
+extern uint16_t eepromWrites;       /// Number of bytes written to the EEPROM.
+/**
+ * Number of further bytes, which can be written to the EEPROM before it
+ * ignores all writes (like a reset while writing). Unlimited if negative.
+ */
+extern int16_t eepromWriteLimit;
+
+extern volatile uint8_t admuxa;  /// ADMUXA.
+extern volatile uint8_t admuxb;  /// ADMUXB.
+extern volatile uint8_t adcsra;  /// ADCSRA.
+extern volatile uint16_t adc;    /// ADC (ADCH:ADCL).
+extern volatile uint8_t osccal0; /// OSCCAL0.
+
+/*!
+ * @brief Reset all registers, the signature row and the fuses to zero and
+ *        erase the EEPROM.
+ */
+void reset();
+} // namespace HostShim
+
+#endif // SIGNATURE_HOST_SHIM_HPP
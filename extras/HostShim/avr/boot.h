@@ -0,0 +1,44 @@
+/*!
+ * @file boot.h
+ *
+ * This file is part of the Signature library. It gives easy access to the
+ * signature of AVR microcontrollers. The library contains functions that
+ * provides the information of the signature bytes.
+ *
+ * Copyright (C) 2022-2023  Niklas Kaaf
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ * USA
+ */
+
+/*
+ * Host stand-in for <avr/boot.h>: reads HostShim::signatureRow and
+ * HostShim::fuses.
+ */
+
+#ifndef SIGNATURE_HOST_SHIM_AVR_BOOT_H
+#define SIGNATURE_HOST_SHIM_AVR_BOOT_H
+
+#include "../HostShim.hpp"
+
+#define GET_LOW_FUSE_BITS 0x0000
+#define GET_LOCK_BITS 0x0001
+#define GET_EXTENDED_FUSE_BITS 0x0002
+#define GET_HIGH_FUSE_BITS 0x0003
+
+#define boot_signature_byte_get(address) (HostShim::signatureRow[(address)])
+#define boot_lock_fuse_bits_get(address) (HostShim::fuses[(address)])
+
+#endif // SIGNATURE_HOST_SHIM_AVR_BOOT_H
@@ -0,0 +1,70 @@
+/*!
+ * @file eeprom.h
+ *
+ * This file is part of the Signature library. It gives easy access to the
+ * signature of AVR microcontrollers. The library contains functions that
+ * provides the information of the signature bytes.
+ *
+ * Copyright (C) 2022-2023  Niklas Kaaf
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ * USA
+ */
+
+/*
+ * Host stand-in for <avr/eeprom.h>: works on HostShim::eeprom and counts the
+ * written bytes. Like the hardware, the update functions only write the bytes
+ * that differ.
+ */
+
+#ifndef SIGNATURE_HOST_SHIM_AVR_EEPROM_H
+#define SIGNATURE_HOST_SHIM_AVR_EEPROM_H
+
+#include "../HostShim.hpp"
+
+#include <stddef.h>
+
+static inline uint8_t eeprom_read_byte(const uint8_t *address) {
+  return HostShim::eeprom[(size_t)address];
+}
+
+static inline void eeprom_read_block(void *destination, const void *source,
+                                     size_t size) {
+  for (size_t i = 0; i < size; ++i) {
+    ((uint8_t *)destination)[i] = HostShim::eeprom[(size_t)source + i];
+  }
+}
+
+static inline void eeprom_update_byte(uint8_t *address, uint8_t value) {
+  if (HostShim::eeprom[(size_t)address] == value ||
+      HostShim::eepromWriteLimit == 0) {
+    return;
+  }
+  if (HostShim::eepromWriteLimit > 0) {
+    --HostShim::eepromWriteLimit;
+  }
+  HostShim::eeprom[(size_t)address] = value;
+  ++HostShim::eepromWrites;
+}
+
+static inline void eeprom_update_block(const void *source, void *destination,
+                                       size_t size) {
+  for (size_t i = 0; i < size; ++i) {
+    eeprom_update_byte((uint8_t *)destination + i,
+                       ((const uint8_t *)source)[i]);
+  }
+}
+
+#endif // SIGNATURE_HOST_SHIM_AVR_EEPROM_H
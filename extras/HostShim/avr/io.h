@@ -0,0 +1,55 @@
+/*!
+ * @file io.h
+ *
+ * This file is part of the Signature library. It gives easy access to the
+ * signature of AVR microcontrollers. The library contains functions that
+ * provides the information of the signature bytes.
+ *
+ * Copyright (C) 2022-2023  Niklas Kaaf
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ * USA
+ */
+
+/*
+ * Host stand-in for <avr/io.h>: the registers used by the library, mapped to
+ * the variables of HostShim.hpp.
+ */
+
+#ifndef SIGNATURE_HOST_SHIM_AVR_IO_H
+#define SIGNATURE_HOST_SHIM_AVR_IO_H
+
+#include "../HostShim.hpp"
+
+#define _BV(bit) (1 << (bit))
+
+#if defined(__AVR_ATtiny828__)
+#define E2END 0xFF
+
+#define ADMUXA (HostShim::admuxa)
+#define ADMUXB (HostShim::admuxb)
+#define ADCSRA (HostShim::adcsra)
+#define ADC (HostShim::adc)
+#define OSCCAL0 (HostShim::osccal0)
+
+#define REFS 5
+#define ADEN 7
+#define ADSC 6
+#define ADPS2 2
+#define ADPS1 1
+#define ADPS0 0
+#endif
+
+#endif // SIGNATURE_HOST_SHIM_AVR_IO_H
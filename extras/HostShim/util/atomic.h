@@ -0,0 +1,39 @@
+/*!
+ * @file atomic.h
+ *
+ * This file is part of the Signature library. It gives easy access to the
+ * signature of AVR microcontrollers. The library contains functions that
+ * provides the information of the signature bytes.
+ *
+ * Copyright (C) 2022-2023  Niklas Kaaf
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ * USA
+ */
+
+/*
+ * Host stand-in for <util/atomic.h>: the host has no interrupts, so the block
+ * is executed once as it is.
+ */
+
+#ifndef SIGNATURE_HOST_SHIM_UTIL_ATOMIC_H
+#define SIGNATURE_HOST_SHIM_UTIL_ATOMIC_H
+
+#define ATOMIC_RESTORESTATE 0
+#define ATOMIC_FORCEON 1
+#define ATOMIC_BLOCK(type)                                                     \
+  for (bool atomic_once = true; atomic_once; atomic_once = false)
+
+#endif // SIGNATURE_HOST_SHIM_UTIL_ATOMIC_H
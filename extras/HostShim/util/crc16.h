@@ -0,0 +1,43 @@
+/*!
+ * @file crc16.h
+ *
+ * This file is part of the Signature library. It gives easy access to the
+ * signature of AVR microcontrollers. The library contains functions that
+ * provides the information of the signature bytes.
+ *
+ * Copyright (C) 2022-2023  Niklas Kaaf
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ * USA
+ */
+
+/*
+ * Host stand-in for <util/crc16.h>: the C equivalent of the avr-libc
+ * assembler implementation.
+ */
+
+#ifndef SIGNATURE_HOST_SHIM_UTIL_CRC16_H
+#define SIGNATURE_HOST_SHIM_UTIL_CRC16_H
+
+#include <stdint.h>
+
+static inline uint16_t _crc_ccitt_update(uint16_t crc, uint8_t data) {
+  data ^= crc & 0xFF;
+  data ^= data << 4;
+  return ((((uint16_t)data << 8) | (crc >> 8)) ^ (uint8_t)(data >> 4) ^
+          ((uint16_t)data << 3));
+}
+
+#endif // SIGNATURE_HOST_SHIM_UTIL_CRC16_H
@@ -0,0 +1,122 @@
+/*!
+ * @file ResponderTest.cpp
+ *
+ * This file is part of the Signature library. It gives easy access to the
+ * signature of AVR microcontrollers. The library contains functions that
+ * provides the information of the signature bytes.
+ *
+ * Copyright (C) 2022-2023  Niklas Kaaf
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ * USA
+ */
+
+/*
+ * Host loopback test of the Responder protocol for the ATtiny828, with a
+ * synthetic SignatureInfo. Every query is passed to query() like a received
+ * byte, the answer is collected with available() and next() like the
+ * interrupts do. Without __AVR__ the transports are left out, so no
+ * stand-ins are needed.
+ *
+ * Build:   g++ -std=c++11 -D__AVR_ATtiny828__ -o ResponderTest
+ *              ResponderTest.cpp ../../src/Responder.cpp
+ * Usage:   ResponderTest
+ *
+ * The exit code is 1 if a check failed.
+ */
+
+#include <cstdio>
+#include <vector>
+
+#include "../../src/Responder.hpp"
+
+/*!
+ * @def CHECK
+ * @brief Report a failed condition and continue.
+ */
+#define CHECK(condition)                                                       \
+  if (!(condition)) {                                                          \
+    printf("%s:%d: %s\n", __FILE__, __LINE__, #condition);                     \
+    ++failures;                                                                \
+  }
+
+static int failures = 0;
+
+/** Synthetic snapshot: signature of the ATtiny828, calibration 0xA0-0xA5. */
+static const SignatureInfo INFO(0x1E, 0x93, 0x14, 0xA0, 0xA1, 0xA2, 0xA3,
+                                0xA4, 0xA5);
+
+/*!
+ * @brief Send a query and collect the answer.
+ */
+static std::vector<uint8_t> loopback(uint8_t query) {
+  Responder::query(query);
+  std::vector<uint8_t> answer;
+  while (Responder::available() && answer.size() <= SignatureInfo::SIZE) {
+    answer.push_back(Responder::next());
+  }
+  return answer;
+}
+
+static void testSignature() {
+  CHECK(loopback(Responder::SIGNATURE) ==
+        std::vector<uint8_t>({3, 0x1E, 0x93, 0x14}));
+}
+
+static void testRecord() {
+  std::vector<uint8_t> expected(1, SignatureInfo::SIZE);
+  expected.insert(expected.end(), INFO.getBytes(),
+                  INFO.getBytes() + SignatureInfo::SIZE);
+  CHECK(loopback(Responder::RECORD) == expected);
+}
+
+static void testCalibration() {
+  for (uint8_t n = 0; n < SignatureInfo::SIZE - 3; ++n) {
+    CHECK(loopback(Responder::CALIBRATION | n) ==
+          std::vector<uint8_t>({1, (uint8_t)(0xA0 + n)}));
+  }
+  for (uint8_t n = SignatureInfo::SIZE - 3; n < 16; ++n) {
+    CHECK(loopback(Responder::CALIBRATION | n) == std::vector<uint8_t>({0}));
+  }
+}
+
+static void testUnknown() {
+  const uint8_t queries[] = {0x00, 0x03, 0x0F, 0x20, 0xFF};
+  for (uint8_t query : queries) {
+    CHECK(loopback(query) == std::vector<uint8_t>({0}));
+  }
+}
+
+static void testReplace() {
+  // A new query replaces an answer not sent completely.
+  Responder::query(Responder::RECORD);
+  Responder::next();
+  Responder::next();
+  CHECK(loopback(Responder::CALIBRATION | 5) ==
+        std::vector<uint8_t>({1, 0xA5}));
+  CHECK(!Responder::available());
+  CHECK(Responder::next() == 0);
+}
+
+int main() {
+  Responder::begin(INFO);
+  CHECK(!Responder::available());
+  testSignature();
+  testRecord();
+  testCalibration();
+  testUnknown();
+  testReplace();
+  return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,164 @@
+/*!
+ * @file TelemetryTest.cpp
+ *
+ * This file is part of the Signature library. It gives easy access to the
+ * signature of AVR microcontrollers. The library contains functions that
+ * provides the information of the signature bytes.
+ *
+ * Copyright (C) 2022-2023  Niklas Kaaf
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ * USA
+ */
+
+/*
+ * Host test of Telemetry against extras/HostShim, for the ATtiny828.
+ *
+ * Build:   g++ -std=c++11 -D__AVR_ATtiny828__ -I../HostShim -o TelemetryTest
+ *              TelemetryTest.cpp ../HostShim/HostShim.cpp
+ *              ../../src/Telemetry.cpp ../../src/Signature.cpp
+ *              ../../src/SignatureInfo.cpp ../../src/Features.cpp
+ * Usage:   TelemetryTest
+ *
+ * The exit code is 1 if a check failed.
+ */
+
+#include <cstdio>
+
+#include "../../src/Devices.hpp"
+#include "../../src/Telemetry.hpp"
+#include "../HostShim/HostShim.hpp"
+
+#include <avr/boot.h>
+
+/*!
+ * @def CHECK
+ * @brief Report a failed condition and continue.
+ */
+#define CHECK(condition)                                                       \
+  if (!(condition)) {                                                          \
+    printf("%s:%d: %s\n", __FILE__, __LINE__, #condition);                     \
+    ++failures;                                                                \
+  }
+
+static int failures = 0;
+
+/** EEPROM address of the record. */
+static const uint16_t ADDRESS = 0x40;
+
+/*!
+ * @brief Set up an ATtiny828 with an erased EEPROM.
+ */
+static void setUp() {
+  HostShim::reset();
+  HostShim::signatureRow[SIGNATURE_BYTE_1_ADDRESS] = 0x1E;
+  HostShim::signatureRow[SIGNATURE_BYTE_2_ADDRESS] = 0x93;
+  HostShim::signatureRow[SIGNATURE_BYTE_3_ADDRESS] = 0x14;
+#define WRITE_FIELD(index, address, label)                                     \
+  HostShim::signatureRow[address] = 0x40 + SignatureInfo::index;
+  FEATURE_LAYOUT(WRITE_FIELD)
+#undef WRITE_FIELD
+  HostShim::fuses[GET_LOW_FUSE_BITS] = 0xE2;
+  HostShim::fuses[GET_HIGH_FUSE_BITS] = 0xDF;
+  HostShim::fuses[GET_EXTENDED_FUSE_BITS] = 0xFF;
+  HostShim::fuses[GET_LOCK_BITS] = 0xFF;
+}
+
+static void testFirstBoot() {
+  setUp();
+  uint8_t report[Telemetry::MAX_REPORT_SIZE];
+  uint8_t size = Telemetry::report(report, ADDRESS);
+
+  CHECK(size == Telemetry::MAX_REPORT_SIZE);
+  CHECK(report[0] == (Telemetry::CHANGED | Telemetry::VERSION));
+  CHECK(report[1] == Telemetry::SIZE);
+  CHECK(report[2] == SignatureInfo::SIGNATURE_BYTE_1 && report[3] == 0x1E);
+  CHECK(report[2 + 2 * Telemetry::HIGH_FUSE] == Telemetry::HIGH_FUSE);
+  CHECK(report[3 + 2 * Telemetry::HIGH_FUSE] == 0xDF);
+  CHECK(HostShim::eepromWrites == 0);
+
+  // Not acknowledged, so the next boot reports everything again.
+  CHECK(Telemetry::report(report, ADDRESS) == Telemetry::MAX_REPORT_SIZE);
+}
+
+static void testUnchanged() {
+  setUp();
+  uint8_t report[Telemetry::MAX_REPORT_SIZE];
+  Telemetry::report(report, ADDRESS);
+  Telemetry::acknowledge(ADDRESS);
+  CHECK(HostShim::eepromWrites > 0);
+
+  HostShim::eepromWrites = 0;
+  CHECK(Telemetry::report(report, ADDRESS) == 2);
+  CHECK(report[0] == (Telemetry::UNCHANGED | Telemetry::VERSION));
+  CHECK(report[1] == 0);
+  Telemetry::acknowledge(ADDRESS);
+  CHECK(HostShim::eepromWrites == 0);
+}
+
+static void testSingleChange() {
+  setUp();
+  uint8_t report[Telemetry::MAX_REPORT_SIZE];
+  Telemetry::report(report, ADDRESS);
+  Telemetry::acknowledge(ADDRESS);
+
+  HostShim::fuses[GET_HIGH_FUSE_BITS] = 0xD7;
+  HostShim::eepromWrites = 0;
+  CHECK(Telemetry::report(report, ADDRESS) == 4);
+  CHECK(report[0] == (Telemetry::CHANGED | Telemetry::VERSION));
+  CHECK(report[1] == 1);
+  CHECK(report[2] == Telemetry::HIGH_FUSE);
+  CHECK(report[3] == 0xD7);
+  CHECK(HostShim::eepromWrites == 0);
+
+  // The fuse and the two bytes of the CRC, plus invalidating the version.
+  Telemetry::acknowledge(ADDRESS);
+  CHECK(HostShim::eepromWrites <= 5);
+  CHECK(Telemetry::report(report, ADDRESS) == 2);
+}
+
+static void testTornWrite() {
+  for (int16_t limit = 0;; ++limit) {
+    setUp();
+    uint8_t report[Telemetry::MAX_REPORT_SIZE];
+    Telemetry::acknowledge(ADDRESS);
+
+    // A reset after some bytes of the record have been written.
+    HostShim::fuses[GET_HIGH_FUSE_BITS] = 0xD7;
+    HostShim::eepromWrites = 0;
+    HostShim::eepromWriteLimit = limit;
+    Telemetry::acknowledge(ADDRESS);
+    HostShim::eepromWriteLimit = -1;
+
+    // The new record, the old record or no record, but never a wrong base.
+    uint8_t size = Telemetry::report(report, ADDRESS);
+    CHECK(size == 2 || size == 4 || size == Telemetry::MAX_REPORT_SIZE);
+    if (size == 4) {
+      CHECK(report[2] == Telemetry::HIGH_FUSE && report[3] == 0xD7);
+    }
+    if (HostShim::eepromWrites < limit) {
+      CHECK(size == 2);
+      break;
+    }
+  }
+}
+
+int main() {
+  testFirstBoot();
+  testUnchanged();
+  testSingleChange();
+  testTornWrite();
+  return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,220 @@
+/*!
+ * @file OscillatorSimulation.cpp
+ *
+ * This file is part of the Signature library. It gives easy access to the
+ * signature of AVR microcontrollers. The library contains functions that
+ * provides the information of the signature bytes.
+ *
+ * Copyright (C) 2022-2023  Niklas Kaaf
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ * USA
+ */
+
+/*
+ * Host tool simulating the oscillator temperature compensation
+ * (OscillatorTrim) with a scripted temperature profile. It runs the
+ * OscillatorTrim of the library for the ATtiny828 against the register
+ * stand-ins of extras/HostShim: one update(now) per tick, and an ADC
+ * conversion finishes (ADSC is cleared) after a number of updates.
+ *
+ * Build:   g++ -std=c++11 -O2 -D__AVR_ATtiny828__ -I../HostShim
+ *              -o OscillatorSimulation OscillatorSimulation.cpp
+ *              ../HostShim/HostShim.cpp ../../src/OscillatorTrim.cpp
+ *              ../../src/OscillatorModel.cpp ../../src/Signature.cpp
+ *              ../../src/SignatureInfo.cpp ../../src/Features.cpp
+ * Usage:   OscillatorSimulation [--coefficient N] [--interval MS] [--tick MS]
+ *                               [--conversion N] [--factory N] [--gain N]
+ *                               [--offset N] [profile]
+ *
+ * The profile has one point per line, "<time in s> <temperature in °C>", and
+ * is interpolated linearly between the points. Without a file, the profile is
+ * read from stdin. Per sample, one CSV line is written:
+ *
+ *   time in ms, temperature, measured temperature, target, OSCCAL0, error
+ *
+ * with the error being the distance of OSCCAL0 to the ideal value of the
+ * actual temperature. The exit code is 1 if the error does not return to at
+ * most one step before the next sample, or if a conversion is started with
+ * the ADC disabled, without a prescaler or on another channel than the
+ * temperature sensor.
+ */
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include "../../src/Devices.hpp"
+#include "../../src/OscillatorModel.hpp"
+#include "../../src/OscillatorTrim.hpp"
+#include "../../src/SignatureInfo.hpp"
+#include "../HostShim/HostShim.hpp"
+
+#include <avr/io.h>
+
+/** Point of the temperature profile. */
+struct Point {
+  double time;        /// Time in seconds.
+  double temperature; /// Temperature in °C.
+};
+
+/*!
+ * @brief Interpolate the temperature of the profile at a time.
+ */
+static double temperatureAt(const std::vector<Point> &profile, double time) {
+  if (time <= profile.front().time) {
+    return profile.front().temperature;
+  }
+  for (size_t i = 1; i < profile.size(); ++i) {
+    if (time <= profile[i].time) {
+      const Point &a = profile[i - 1];
+      const Point &b = profile[i];
+      return a.temperature + (b.temperature - a.temperature) *
+                                 (time - a.time) / (b.time - a.time);
+    }
+  }
+  return profile.back().temperature;
+}
+
+/*!
+ * @brief Check the registers when a conversion is started.
+ */
+static bool isSampling() {
+  return (ADCSRA & _BV(ADEN)) &&
+         (ADCSRA & (_BV(ADPS2) | _BV(ADPS1) | _BV(ADPS0))) ==
+             OSCILLATOR_TRIM_ADC_PRESCALER &&
+         ADMUXA == OSCILLATOR_TRIM_TEMPERATURE_CHANNEL &&
+         ADMUXB == _BV(REFS);
+}
+
+static int usage(const char *name) {
+  fprintf(stderr,
+          "Usage: %s [--coefficient N] [--interval MS] [--tick MS] "
+          "[--conversion N] [--factory N] [--gain N] [--offset N] "
+          "[profile]\n",
+          name);
+  return 2;
+}
+
+int main(int argc, char **argv) {
+  int8_t coefficient = -4;
+  uint32_t interval = 10000;
+  uint32_t tick = 10;
+  uint32_t conversion = 1;
+  uint8_t factory = 0x80;
+  uint8_t gain = 128;
+  uint8_t offset = 0;
+  FILE *file = stdin;
+
+  for (int i = 1; i < argc; ++i) {
+    if (i + 1 < argc && strcmp(argv[i], "--coefficient") == 0) {
+      coefficient = (int8_t)atoi(argv[++i]);
+    } else if (i + 1 < argc && strcmp(argv[i], "--interval") == 0) {
+      interval = (uint32_t)atol(argv[++i]);
+    } else if (i + 1 < argc && strcmp(argv[i], "--tick") == 0) {
+      tick = (uint32_t)atol(argv[++i]);
+    } else if (i + 1 < argc && strcmp(argv[i], "--conversion") == 0) {
+      conversion = (uint32_t)atol(argv[++i]);
+    } else if (i + 1 < argc && strcmp(argv[i], "--factory") == 0) {
+      factory = (uint8_t)strtol(argv[++i], nullptr, 0);
+    } else if (i + 1 < argc && strcmp(argv[i], "--gain") == 0) {
+      gain = (uint8_t)strtol(argv[++i], nullptr, 0);
+    } else if (i + 1 < argc && strcmp(argv[i], "--offset") == 0) {
+      offset = (uint8_t)strtol(argv[++i], nullptr, 0);
+    } else if (argv[i][0] == '-' || file != stdin) {
+      return usage(argv[0]);
+    } else if ((file = fopen(argv[i], "r")) == nullptr) {
+      perror(argv[i]);
+      return 2;
+    }
+  }
+  if (tick == 0 || conversion == 0) {
+    return usage(argv[0]);
+  }
+
+  std::vector<Point> profile;
+  Point point;
+  while (fscanf(file, "%lf %lf", &point.time, &point.temperature) == 2) {
+    profile.push_back(point);
+  }
+  if (profile.empty()) {
+    fprintf(stderr, "The profile is empty\n");
+    return 2;
+  }
+
+  // Signature row of an ATtiny828 with the given factory calibration.
+  uint8_t bytes[SignatureInfo::SIZE] = {};
+  bytes[SignatureInfo::INTERNAL_8MHZ_OSCILLATOR_CALIBRATION] = factory;
+  bytes[SignatureInfo::TEMPERATURE_SENSOR_GAIN_CALIBRATION] = gain;
+  bytes[SignatureInfo::TEMPERATURE_SENSOR_OFFSET_CALIBRATION] = offset;
+
+  HostShim::reset();
+  HostShim::signatureRow[SIGNATURE_BYTE_1_ADDRESS] = 0x1E;
+  HostShim::signatureRow[SIGNATURE_BYTE_2_ADDRESS] = 0x93;
+  HostShim::signatureRow[SIGNATURE_BYTE_3_ADDRESS] = 0x14;
+#define WRITE_FIELD(index, address, label)                                     \
+  HostShim::signatureRow[address] = bytes[SignatureInfo::index];
+  FEATURE_LAYOUT(WRITE_FIELD)
+#undef WRITE_FIELD
+  OSCCAL0 = factory;
+  OscillatorTrim::begin(coefficient, interval);
+
+  const uint32_t end = (uint32_t)(profile.back().time * 1000);
+  uint32_t pending = 0;
+  bool sampled = false;
+  bool converged = true;
+  bool valid = true;
+  int error = 0;
+
+  printf("time,temperature,measured,target,osccal0,error\n");
+  for (uint32_t now = 0; now <= end; now += tick) {
+    const double temperature = temperatureAt(profile, now / 1000.0);
+
+    // The ADC: a started conversion takes a number of updates.
+    if (ADCSRA & _BV(ADSC)) {
+      if (pending == 0 && !isSampling()) {
+        valid = false;
+      }
+      if (++pending >= conversion) {
+        ADC = OscillatorModel::toAdc((int16_t)(temperature + 0.5), gain,
+                                     offset);
+        ADCSRA &= ~_BV(ADSC);
+        pending = 0;
+      }
+    }
+
+    const bool sampling = ADCSRA & _BV(ADEN);
+    if (sampling && error > 1 && !sampled) {
+      converged = false;
+    }
+    sampled = sampling;
+    OscillatorTrim::update(now);
+    if (sampled && !(ADCSRA & _BV(ADEN))) {
+      printf("%u,%.1f,%d,%u,%u,%d\n", now, temperature,
+             OscillatorTrim::getTemperature(), OscillatorTrim::getTarget(),
+             OSCCAL0, error);
+    }
+
+    const uint8_t ideal = OscillatorModel::toCalibration(
+        (int16_t)(temperature + 0.5), factory, coefficient);
+    error = abs((int)OSCCAL0 - (int)ideal);
+  }
+  if (!valid) {
+    fprintf(stderr, "A conversion was started with invalid ADC settings\n");
+  }
+  return converged && valid ? 0 : 1;
+}
@@ -0,0 +1,441 @@
+/*!
+ * @file SignatureDecoder.cpp
+ *
+ * This file is part of the Signature library. It gives easy access to the
+ * signature of AVR microcontrollers. The library contains functions that
+ * provides the information of the signature bytes.
+ *
+ * Copyright (C) 2022-2023  Niklas Kaaf
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ * USA
+ */
+
+/*
+ * Host tool decoding dumps of the signature row, e.g. read with avrdude, with
+ * the same addresses, layouts, labels and summary text as the library
+ * (src/Devices.hpp).
+ *
+ * Build:   g++ -std=c++17 -O2 -pthread -o SignatureDecoder SignatureDecoder.cpp
+ * Usage:   SignatureDecoder [--summary | --json | --binary] [--jobs N]
+ *                           <file | directory>...
+ *
+ * Dumps are either raw (offset = address in the signature row; a 3 byte dump
+ * is the "signature" memory of avrdude) or Intel HEX (detected by a leading
+ * ':'). Directories are searched recursively (without following symbolic
+ * links to directories) and all files are decoded in parallel; the output
+ * keeps the order of the files. Entries which can not be read are reported
+ * like dumps which can not be decoded, and the exit code is 1.
+ *
+ * Outputs:
+ *   --summary  Text in the format of Signature::getSummary() (default).
+ *   --json     One JSON object per line. For devices with the UNVERIFIED
+ *              layout, "calibration" is null and "row" holds the whole dump.
+ *   --binary   Per dump one length byte followed by the bytes in the order of
+ *              SignatureInfo (signature, then the calibration bytes of the
+ *              layout), i.e. the same record the device sends. A dump which
+ *              does not contain all calibration bytes of the layout fails.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../SignatureLookup/SignatureLookup.hpp"
+
+namespace fs = std::filesystem;
+
+/** Output format. */
+enum class Format { SUMMARY, JSON, BINARY };
+
+/** Dump to decode. */
+struct Entry {
+  fs::path path;     /// Path of the dump.
+  std::string error; /// Set if the entry can not be read.
+};
+
+/** Signature row read from a dump. */
+struct Row {
+  std::vector<uint8_t> bytes; /// Bytes by address.
+  std::vector<bool> present;  /// Address was part of the dump.
+
+  void set(size_t address, uint8_t value) {
+    if (address >= bytes.size()) {
+      bytes.resize(address + 1);
+      present.resize(address + 1);
+    }
+    bytes[address] = value;
+    present[address] = true;
+  }
+
+  bool has(size_t address) const {
+    return address < present.size() && present[address];
+  }
+};
+
+static int hexDigit(char c) {
+  if (c >= '0' && c <= '9') {
+    return c - '0';
+  }
+  if (c >= 'a' && c <= 'f') {
+    return c - 'a' + 10;
+  }
+  if (c >= 'A' && c <= 'F') {
+    return c - 'A' + 10;
+  }
+  return -1;
+}
+
+/*!
+ * @brief Parse an Intel HEX file into a row.
+ *
+ * @return    Empty string on success, otherwise the error.
+ */
+static std::string parseIntelHex(const std::string &text, Row &row) {
+  uint32_t base = 0;
+  size_t lineNumber = 0;
+  size_t position = 0;
+  while (position < text.size()) {
+    size_t end = text.find('\n', position);
+    if (end == std::string::npos) {
+      end = text.size();
+    }
+    std::string line = text.substr(position, end - position);
+    position = end + 1;
+    lineNumber++;
+    while (!line.empty() && (line.back() == '\r' || line.back() == ' ')) {
+      line.pop_back();
+    }
+    if (line.empty()) {
+      continue;
+    }
+    if (line[0] != ':' || line.size() < 11 || line.size() % 2 == 0) {
+      return "invalid record in line " + std::to_string(lineNumber);
+    }
+
+    std::vector<uint8_t> record;
+    for (size_t i = 1; i < line.size(); i += 2) {
+      int high = hexDigit(line[i]);
+      int low = hexDigit(line[i + 1]);
+      if (high < 0 || low < 0) {
+        return "invalid digit in line " + std::to_string(lineNumber);
+      }
+      record.push_back((uint8_t)(high << 4 | low));
+    }
+    uint8_t checksum = 0;
+    for (uint8_t byte : record) {
+      checksum += byte;
+    }
+    if (checksum != 0 || record.size() != (size_t)record[0] + 5) {
+      return "invalid checksum or length in line " +
+             std::to_string(lineNumber);
+    }
+
+    const uint8_t count = record[0];
+    const uint16_t address = (uint16_t)(record[1] << 8 | record[2]);
+    const uint32_t first = base + address;
+    switch (record[3]) {
+    case 0x00:
+      if (count > 0 && (first > 0xFFFF || 0xFFFF - first < count - 1u)) {
+        return "address out of range in line " + std::to_string(lineNumber);
+      }
+      for (uint8_t i = 0; i < count; ++i) {
+        row.set(first + i, record[4 + i]);
+      }
+      break;
+    case 0x01:
+      return "";
+    case 0x02:
+    case 0x04:
+      if (count != 2) {
+        return "invalid extended address in line " +
+               std::to_string(lineNumber);
+      }
+      base = (uint32_t)(record[4] << 8 | record[5]);
+      base <<= record[3] == 0x02 ? 4 : 16;
+      break;
+    default:
+      break;
+    }
+  }
+  return "";
+}
+
+static std::string hex(uint32_t value, int digits) {
+  char text[16];
+  snprintf(text, sizeof(text), "%0*X", digits, value);
+  return text;
+}
+
+static std::string escapeJson(const std::string &text) {
+  std::string escaped;
+  for (char c : text) {
+    if (c == '"' || c == '\\') {
+      escaped += '\\';
+    }
+    escaped += c;
+  }
+  return escaped;
+}
+
+/*!
+ * @brief Report a dump which can not be decoded.
+ *
+ * @return    The output for the dump (JSON only, the others use stderr).
+ */
+static std::string fail(const fs::path &path, Format format,
+                        const std::string &error) {
+  if (format == Format::JSON) {
+    return "{\"file\":\"" + escapeJson(path.string()) + "\",\"error\":\"" +
+           escapeJson(error) + "\"}\n";
+  }
+  fprintf(stderr, "%s: %s\n", path.string().c_str(), error.c_str());
+  return "";
+}
+
+/*!
+ * @brief Decode one dump.
+ *
+ * @param failed  Output, set if the dump can not be decoded.
+ * @return    The output for the dump.
+ */
+static std::string decode(const Entry &entry, Format format, char &failed) {
+  const fs::path &path = entry.path;
+  if (!entry.error.empty()) {
+    failed = true;
+    return fail(path, format, entry.error);
+  }
+
+  std::ifstream file(path, std::ios::binary);
+  std::string content((std::istreambuf_iterator<char>(file)),
+                      std::istreambuf_iterator<char>());
+  std::string error;
+  Row row;
+  if (!file && !file.eof()) {
+    error = "can not be read";
+  } else if (!content.empty() && content[0] == ':') {
+    error = parseIntelHex(content, row);
+  } else {
+    for (size_t i = 0; i < content.size(); ++i) {
+      row.set(i, (uint8_t)content[i]);
+    }
+  }
+
+  // A dump of the "signature" memory of avrdude only contains the three
+  // signature bytes, without the gaps of the signature row.
+  const size_t addresses[3] = {SIGNATURE_BYTE_1_ADDRESS,
+                               SIGNATURE_BYTE_2_ADDRESS,
+                               SIGNATURE_BYTE_3_ADDRESS};
+  if (error.empty() && row.bytes.size() == 3) {
+    Row signatureRow;
+    for (size_t i = 0; i < 3; ++i) {
+      signatureRow.set(addresses[i], row.bytes[i]);
+    }
+    row = signatureRow;
+  }
+  if (error.empty() &&
+      !(row.has(addresses[0]) && row.has(addresses[1]) &&
+        row.has(addresses[2]))) {
+    error = "does not contain the signature";
+  }
+  if (!error.empty()) {
+    failed = true;
+    return fail(path, format, error);
+  }
+
+  const uint32_t signature = SignatureLookup::toSignature(
+      row.bytes[addresses[0]], row.bytes[addresses[1]],
+      row.bytes[addresses[2]]);
+  const SignatureLookup::Device *device = SignatureLookup::lookup(signature);
+  const SignatureLookup::Layout *layout = device ? device->layout : nullptr;
+  const uint8_t calibrationBytes = layout ? layout->size : 0;
+  const bool verified = layout && SignatureLookup::isVerified(layout);
+
+  std::string output;
+  switch (format) {
+  case Format::SUMMARY:
+    output = SIGNATURE_SUMMARY_TITLE;
+    output += device ? device->name : "UNKNOWN";
+    output += " (0x" + hex(signature, 6) + ")";
+    for (uint8_t i = 0; i < calibrationBytes; ++i) {
+      const SignatureLookup::CalibrationByte &byte = layout->bytes[i];
+      if (row.has(byte.address)) {
+        output += SIGNATURE_SUMMARY_FIELD;
+        output += byte.label;
+        output += SIGNATURE_SUMMARY_VALUE + hex(row.bytes[byte.address], 1);
+      }
+    }
+    output = "# " + path.string() +
+             (verified ? "" : " (calibration bytes unknown)") + "\n" + output +
+             "\n";
+    break;
+  case Format::JSON:
+    output = "{\"file\":\"" + escapeJson(path.string()) + "\",\"chip\":";
+    output += device ? "\"" + std::string(device->name) + "\"" : "null";
+    output += ",\"signature\":\"0x" + hex(signature, 6) + "\"";
+    if (device) {
+      output += ",\"flashSize\":" + std::to_string(device->flashSize);
+      output += ",\"ramSize\":" + std::to_string(device->ramSize);
+    }
+    if (verified) {
+      output += ",\"calibration\":{";
+      for (uint8_t i = 0, written = 0; i < calibrationBytes; ++i) {
+        const SignatureLookup::CalibrationByte &byte = layout->bytes[i];
+        if (row.has(byte.address)) {
+          output += written++ ? "," : "";
+          output += "\"" + std::string(byte.index) +
+                    "\":" + std::to_string(row.bytes[byte.address]);
+        }
+      }
+      output += "}";
+    } else {
+      // The calibration bytes are unknown, so keep the whole row instead.
+      output += ",\"calibration\":null,\"row\":{";
+      for (size_t address = 0, written = 0; address < row.bytes.size();
+           ++address) {
+        if (row.has(address)) {
+          output += written++ ? "," : "";
+          output += "\"0x" + hex((uint32_t)address, 2) +
+                    "\":" + std::to_string(row.bytes[address]);
+        }
+      }
+      output += "}";
+    }
+    output += "}\n";
+    break;
+  case Format::BINARY:
+    // The record has no room for missing bytes, and no value is safe as a
+    // placeholder (0xFF is a valid calibration).
+    for (uint8_t i = 0; i < calibrationBytes; ++i) {
+      if (!row.has(layout->bytes[i].address)) {
+        failed = true;
+        return fail(path, format, "does not contain the calibration bytes");
+      }
+    }
+    output.push_back((char)(3 + calibrationBytes));
+    for (size_t address : addresses) {
+      output.push_back((char)row.bytes[address]);
+    }
+    for (uint8_t i = 0; i < calibrationBytes; ++i) {
+      output.push_back((char)row.bytes[layout->bytes[i].address]);
+    }
+    break;
+  }
+  return output;
+}
+
+/*!
+ * @brief Collect the files of a directory and its subdirectories. Entries
+ *        which can not be read are collected with their error.
+ *
+ * @param entries Output, receives the entries.
+ */
+static void collect(const fs::path &directory, std::vector<Entry> &entries) {
+  std::error_code errorCode;
+  fs::directory_iterator iterator(directory, errorCode);
+  for (; !errorCode && iterator != fs::directory_iterator();
+       iterator.increment(errorCode)) {
+    std::error_code entryError;
+    const fs::file_status status = iterator->symlink_status(entryError);
+    if (entryError) {
+      entries.push_back({iterator->path(), entryError.message()});
+    } else if (fs::is_directory(status)) {
+      collect(iterator->path(), entries);
+    } else if (iterator->is_regular_file(entryError)) {
+      entries.push_back({iterator->path(), ""});
+    } else if (entryError) {
+      entries.push_back({iterator->path(), entryError.message()});
+    }
+  }
+  if (errorCode) {
+    entries.push_back({directory, errorCode.message()});
+  }
+}
+
+static int usage(const char *name) {
+  fprintf(stderr,
+          "Usage: %s [--summary | --json | --binary] [--jobs N] "
+          "<file | directory>...\n",
+          name);
+  return 2;
+}
+
+int main(int argc, char **argv) {
+  Format format = Format::SUMMARY;
+  unsigned jobs = std::max(1u, std::thread::hardware_concurrency());
+  std::vector<Entry> entries;
+
+  for (int i = 1; i < argc; ++i) {
+    const std::string argument = argv[i];
+    if (argument == "--summary") {
+      format = Format::SUMMARY;
+    } else if (argument == "--json") {
+      format = Format::JSON;
+    } else if (argument == "--binary") {
+      format = Format::BINARY;
+    } else if (argument == "--jobs" && i + 1 < argc) {
+      jobs = std::max(1, atoi(argv[++i]));
+    } else if (argument.rfind("--", 0) == 0) {
+      return usage(argv[0]);
+    } else {
+      std::error_code errorCode;
+      if (fs::is_directory(argument, errorCode)) {
+        std::vector<Entry> files;
+        collect(argument, files);
+        std::sort(files.begin(), files.end(),
+                  [](const Entry &a, const Entry &b) {
+                    return a.path < b.path;
+                  });
+        entries.insert(entries.end(), files.begin(), files.end());
+      } else {
+        entries.push_back({argument, ""});
+      }
+    }
+  }
+  if (entries.empty()) {
+    return usage(argv[0]);
+  }
+
+  std::vector<std::string> outputs(entries.size());
+  std::vector<char> failed(entries.size());
+  std::atomic<size_t> next(0);
+  auto worker = [&]() {
+    for (size_t i = next++; i < entries.size(); i = next++) {
+      outputs[i] = decode(entries[i], format, failed[i]);
+    }
+  };
+  std::vector<std::thread> threads;
+  for (unsigned i = 1; i < std::min<size_t>(jobs, entries.size()); ++i) {
+    threads.emplace_back(worker);
+  }
+  worker();
+  for (std::thread &thread : threads) {
+    thread.join();
+  }
+
+  for (const std::string &output : outputs) {
+    fwrite(output.data(), 1, output.size(), stdout);
+  }
+  return std::find(failed.begin(), failed.end(), true) != failed.end() ? 1 : 0;
+}
@@ -0,0 +1,292 @@
+/*!
+ * @file SignatureLookup.hpp
+ *
+ * This file is part of the Signature library. It gives easy access to the
+ * signature of AVR microcontrollers. The library contains functions that
+ * provides the information of the signature bytes.
+ *
+ * Copyright (C) 2022-2023  Niklas Kaaf
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ * USA
+ */
+
+#ifndef SIGNATURE_SIGNATURE_LOOKUP_HPP
+#define SIGNATURE_SIGNATURE_LOOKUP_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "../../src/Devices.hpp"
+
+/*!
+ * @brief   Host-side lookup of 24-bit signatures (e.g. 0x1E950F) in the device
+ *          list of the library (SIGNATURE_DEVICES).
+ *
+ * The lookup uses a minimal perfect hash (hash and displace), which is built at
+ * compile time. Every lookup costs two hash evaluations, three table reads and
+ * one comparison to reject unknown signatures.
+ *
+ * @note    Requires C++17. This header is not part of the Arduino library.
+ */
+class SignatureLookup {
+public:
+  /** Calibration byte of a layout. */
+  struct CalibrationByte {
+    const char *index; /// Name of the byte (index in SignatureInfo).
+    uint8_t address;   /// Address of the byte in the signature row.
+    const char *label; /// Readable label of the byte.
+  };
+
+  /** Calibration layout of a device. */
+  struct Layout {
+    const char *name;             /// Name of the layout.
+    const CalibrationByte *bytes; /// Calibration bytes of the layout.
+    uint8_t size;                 /// Number of calibration bytes.
+  };
+
+  /** Device of the device list. */
+  struct Device {
+    const char *name;     /// Name of the chip.
+    uint32_t signature;   /// Signature as a 24-bit value.
+    uint32_t flashSize;   /// Size of the flash in bytes.
+    uint16_t ramSize;     /// Size of the SRAM in bytes.
+    const Layout *layout; /// Calibration layout.
+  };
+
+  /** Device sharing the signature of a device of the device list. */
+  struct Alias {
+    const char *name;     /// Name of the chip.
+    const Device *device; /// Device with the same signature and data.
+  };
+
+  /*!
+   * @brief Check whether the calibration bytes of a layout are known.
+   *
+   * @return    False for the UNVERIFIED layout, whose calibration bytes are
+   *            unknown (unlike NONE, which has none).
+   */
+  static constexpr bool isVerified(const Layout *layout);
+
+  /*!
+   * @brief Combine the three signature bytes to a 24-bit signature.
+   */
+  static constexpr uint32_t toSignature(uint8_t sig1, uint8_t sig2,
+                                        uint8_t sig3) {
+    return (uint32_t)sig1 << 16 | (uint32_t)sig2 << 8 | sig3;
+  }
+
+private:
+#define CALIBRATION_BYTE(index, address, label) {#index, address, label},
+#define LAYOUT(layout)                                                         \
+  static constexpr CalibrationByte LAYOUT_BYTES_##layout[] = {                 \
+      SIGNATURE_LAYOUT_##layout(CALIBRATION_BYTE){nullptr, 0, nullptr}};       \
+  static constexpr Layout LAYOUT_##layout = {                                  \
+      #layout, LAYOUT_BYTES_##layout,                                          \
+      sizeof(LAYOUT_BYTES_##layout) / sizeof(CalibrationByte) - 1};
+  SIGNATURE_LAYOUTS(LAYOUT)
+#undef LAYOUT
+#undef CALIBRATION_BYTE
+
+#define DEVICE(name, sig1, sig2, sig3, flashSize, ramSize, layout)             \
+  {#name, (uint32_t)sig1 << 16 | (uint32_t)sig2 << 8 | sig3, flashSize,        \
+   ramSize, &LAYOUT_##layout},
+  static constexpr Device DEVICES[] = {SIGNATURE_DEVICES(DEVICE)};
+#undef DEVICE
+
+#define DEVICE(name, sig1, sig2, sig3, flashSize, ramSize, layout) INDEX_##name,
+  enum DeviceIndex : uint8_t { SIGNATURE_DEVICES(DEVICE) };
+#undef DEVICE
+
+#define ALIAS(name, device) {#name, &DEVICES[INDEX_##device]},
+  static constexpr Alias ALIASES[] = {SIGNATURE_ALIASES(ALIAS)};
+#undef ALIAS
+
+  static constexpr size_t COUNT = sizeof(DEVICES) / sizeof(Device);
+  static constexpr size_t BUCKETS = (COUNT + 1) / 2;
+  static constexpr uint16_t MAX_DISPLACEMENT = 0xFFFF;
+
+  /** Tables of the perfect hash. */
+  struct PerfectHash {
+    std::array<uint16_t, BUCKETS> displacements; /// Displacement per bucket.
+    std::array<uint32_t, COUNT> signatures;      /// Signature per slot.
+    std::array<uint8_t, COUNT> devices;          /// Device index per slot.
+  };
+
+  /*!
+   * @brief Hash a signature with a seed (murmur3 finalizer).
+   */
+  static constexpr uint32_t mix(uint32_t signature, uint32_t seed) {
+    uint32_t value = signature ^ (seed * 0x9E3779B9u);
+    value ^= value >> 16;
+    value *= 0x85EBCA6Bu;
+    value ^= value >> 13;
+    value *= 0xC2B2AE35u;
+    value ^= value >> 16;
+    return value;
+  }
+
+  /*!
+   * @brief Map a hash value to [0, range) without a division.
+   */
+  static constexpr uint32_t reduce(uint32_t value, uint32_t range) {
+    return (uint32_t)(((uint64_t)value * range) >> 32);
+  }
+
+  static constexpr uint32_t bucketOf(uint32_t signature) {
+    return reduce(mix(signature, 0), BUCKETS);
+  }
+
+  static constexpr uint32_t slotOf(uint32_t signature, uint16_t displacement) {
+    return reduce(mix(signature, (uint32_t)displacement + 1), COUNT);
+  }
+
+  /*!
+   * @brief Build the perfect hash. The largest buckets are placed first, each
+   *        with the first displacement that moves all of its signatures into
+   *        free slots. Duplicated signatures can not be placed and fail the
+   *        compilation.
+   */
+  static constexpr PerfectHash build() {
+    PerfectHash table{};
+    std::array<uint8_t, BUCKETS> sizes{};
+    std::array<uint8_t, BUCKETS> order{};
+    std::array<bool, COUNT> used{};
+
+    for (size_t i = 0; i < COUNT; ++i) {
+      ++sizes[bucketOf(DEVICES[i].signature)];
+    }
+    for (size_t i = 0; i < BUCKETS; ++i) {
+      order[i] = (uint8_t)i;
+      for (size_t j = i; j > 0 && sizes[order[j - 1]] < sizes[order[j]]; --j) {
+        const uint8_t swap = order[j - 1];
+        order[j - 1] = order[j];
+        order[j] = swap;
+      }
+    }
+
+    for (size_t i = 0; i < BUCKETS && sizes[order[i]] > 0; ++i) {
+      const uint8_t bucket = order[i];
+      for (uint32_t displacement = 0;; ++displacement) {
+        if (displacement > MAX_DISPLACEMENT) {
+          throw "Signatures of the device list can not be hashed";
+        }
+        std::array<uint8_t, COUNT> slots{};
+        uint8_t placed = 0;
+        for (size_t device = 0; device < COUNT; ++device) {
+          const uint32_t signature = DEVICES[device].signature;
+          if (bucketOf(signature) != bucket) {
+            continue;
+          }
+          const uint32_t slot = slotOf(signature, (uint16_t)displacement);
+          bool free = !used[slot];
+          for (uint8_t j = 0; j < placed && free; ++j) {
+            free = slots[j] != slot;
+          }
+          if (!free) {
+            break;
+          }
+          slots[placed++] = (uint8_t)slot;
+        }
+        if (placed != sizes[bucket]) {
+          continue;
+        }
+
+        placed = 0;
+        for (size_t device = 0; device < COUNT; ++device) {
+          if (bucketOf(DEVICES[device].signature) == bucket) {
+            const uint8_t slot = slots[placed++];
+            used[slot] = true;
+            table.signatures[slot] = DEVICES[device].signature;
+            table.devices[slot] = (uint8_t)device;
+          }
+        }
+        table.displacements[bucket] = (uint16_t)displacement;
+        break;
+      }
+    }
+    return table;
+  }
+
+  static const PerfectHash TABLE; /// Tables built by build().
+
+public:
+  /*!
+   * @brief Look up a signature.
+   *
+   * @param signature   Signature as a 24-bit value.
+   * @return    The device, or nullptr if the signature is unknown.
+   * @note  Devices sharing the signature are listed by getAliases().
+   */
+  static constexpr const Device *lookup(uint32_t signature) {
+    const uint32_t slot =
+        slotOf(signature, TABLE.displacements[bucketOf(signature)]);
+    return TABLE.signatures[slot] == signature
+               ? &DEVICES[TABLE.devices[slot]]
+               : nullptr;
+  }
+
+  /*!
+   * @brief Look up many signatures at once.
+   *
+   * @param signatures  Signatures as 24-bit values.
+   * @param devices     Output, receives the device (or nullptr if unknown) for
+   *                    every signature.
+   * @param count       Number of signatures.
+   * @return    Number of known signatures.
+   */
+  static size_t lookup(const uint32_t *signatures, const Device **devices,
+                       size_t count) {
+    size_t found = 0;
+    for (size_t i = 0; i < count; ++i) {
+      devices[i] = lookup(signatures[i]);
+      found += devices[i] != nullptr;
+    }
+    return found;
+  }
+
+  /*!
+   * @brief Get all devices of the device list.
+   *
+   * @param count   Output, receives the number of devices.
+   * @return    The devices.
+   */
+  static const Device *getDevices(size_t &count) {
+    count = COUNT;
+    return DEVICES;
+  }
+
+  /*!
+   * @brief Get all devices, which share the signature of a device of the
+   *        device list (e.g. ATmega168 and ATmega168A).
+   *
+   * @param count   Output, receives the number of aliases.
+   * @return    The aliases.
+   */
+  static const Alias *getAliases(size_t &count) {
+    count = sizeof(ALIASES) / sizeof(Alias);
+    return ALIASES;
+  }
+};
+
+inline constexpr SignatureLookup::PerfectHash SignatureLookup::TABLE =
+    SignatureLookup::build();
+
+constexpr bool SignatureLookup::isVerified(const Layout *layout) {
+  return layout != &LAYOUT_UNVERIFIED;
+}
+
+#endif // SIGNATURE_SIGNATURE_LOOKUP_HPP
@@ -0,0 +1,45 @@
+/*!
+ * @file SizeReport.cpp
+ *
+ * This file is part of the Signature library. It gives easy access to the
+ * signature of AVR microcontrollers. The library contains functions that
+ * provides the information of the signature bytes.
+ *
+ * Copyright (C) 2022-2023  Niklas Kaaf
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ * USA
+ */
+
+/*
+ * Minimal program using Signature::getSummary(), built by size-report.sh to
+ * measure the flash and RAM the summary costs without the Arduino core.
+ */
+
+#include "Signature.hpp"
+
+#include <stdlib.h>
+
+/** Receives the summary, so that it is not optimised away. */
+volatile char sink;
+
+int main() {
+  String summary = Signature::getSummary();
+  for (const unsigned char *character = summary; *character; ++character) {
+    sink = *character;
+  }
+  free(summary);
+  return 0;
+}
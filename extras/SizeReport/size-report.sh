@@ -0,0 +1,55 @@
+#!/bin/sh
+#
+# Flash and RAM used by Signature::getSummary() for the ATmega328P (Arduino
+# Uno) and the ATtiny828, built with avr-g++ -Os without the Arduino core
+# (SizeReport.cpp against the sources in src/).
+#
+# Usage:    extras/SizeReport/size-report.sh [base revision]
+#
+# With a base revision (e.g. the target of a pull request), the sources of
+# that revision are measured as well and the difference is printed. The
+# compiler and avr-size can be changed with AVR_CXX and AVR_SIZE.
+
+set -e
+
+CXX=${AVR_CXX:-avr-g++}
+SIZE=${AVR_SIZE:-avr-size}
+MCUS="atmega328p attiny828"
+
+root=$(cd "$(dirname "$0")/../.." && pwd)
+work=$(mktemp -d)
+trap 'rm -rf "$work"' EXIT
+
+# Print "flash ram" of the sources in $1 for the device $2.
+measure() {
+  "$CXX" -mmcu="$2" -Os -std=gnu++11 -ffunction-sections -fdata-sections \
+    -Wl,--gc-sections -I"$1/src" -o "$work/size.elf" \
+    "$root/extras/SizeReport/SizeReport.cpp" "$1"/src/*.cpp
+  "$SIZE" "$work/size.elf" | awk 'NR == 2 { print $1 + $2, $2 + $3 }'
+}
+
+base=$1
+if [ -n "$base" ] && ! git -C "$root" cat-file -e "$base^{commit}" 2>/dev/null
+then
+  echo "Base revision $base not found, measuring the working tree only"
+  base=
+fi
+if [ -n "$base" ]; then
+  mkdir "$work/base"
+  git -C "$root" archive "$base" src | tar -x -C "$work/base"
+fi
+
+printf '%-12s %8s %8s' device flash ram
+[ -n "$base" ] && printf ' %12s %12s' "base flash" "base ram"
+echo
+for mcu in $MCUS; do
+  set -- $(measure "$root" "$mcu")
+  printf '%-12s %8s %8s' "$mcu" "$1" "$2"
+  if [ -n "$base" ]; then
+    flash=$1
+    ram=$2
+    set -- $(measure "$work/base" "$mcu")
+    printf ' %6s (%+d) %6s (%+d)' "$1" $((flash - $1)) "$2" $((ram - $2))
+  fi
+  echo
+done
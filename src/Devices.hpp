@@ -0,0 +1,224 @@
+/*!
+ * @file Devices.hpp
+ *
+ * This file is part of the Signature library. It gives easy access to the
+ * signature of AVR microcontrollers. The library contains functions that
+ * provides the information of the signature bytes.
+ *
+ * Copyright (C) 2022-2023  Niklas Kaaf
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ * USA
+ */
+
+#ifndef SIGNATURE_DEVICES_HPP
+#define SIGNATURE_DEVICES_HPP
+
+/*
+ * This file only contains data in the form of X-macros. It does not depend on
+ * the AVR toolchain, so the same device data can be used by the library on the
+ * microcontroller and by tools on the host.
+ */
+
+/*!
+ * @def SIGNATURE_DEVICES
+ * @brief List of all known devices.
+ *
+ * Every entry calls DEVICE(name, sig1, sig2, sig3, flashSize, ramSize, layout)
+ * with the sizes in bytes and the name of the calibration layout, which
+ * expands to SIGNATURE_LAYOUT_<layout>. The signatures are unique; devices
+ * sharing a signature with an entry are listed in SIGNATURE_ALIASES. The name
+ * is the device name of avr-libc, so the library selects the entry of the
+ * target by __AVR_<name>__.
+ */
+#define SIGNATURE_DEVICES(DEVICE)                                              \
+  DEVICE(ATmega8, 0x1E, 0x93, 0x07, 8192, 1024, UNVERIFIED)                    \
+  DEVICE(ATmega16, 0x1E, 0x94, 0x03, 16384, 1024, UNVERIFIED)                  \
+  DEVICE(ATmega32, 0x1E, 0x95, 0x02, 32768, 2048, UNVERIFIED)                  \
+  DEVICE(ATmega64, 0x1E, 0x96, 0x02, 65536, 4096, UNVERIFIED)                  \
+  DEVICE(ATmega128, 0x1E, 0x97, 0x02, 131072, 4096, UNVERIFIED)                \
+  DEVICE(ATmega162, 0x1E, 0x94, 0x04, 16384, 1024, UNVERIFIED)                 \
+  DEVICE(ATmega8515, 0x1E, 0x93, 0x06, 8192, 512, UNVERIFIED)                  \
+  DEVICE(ATmega8535, 0x1E, 0x93, 0x08, 8192, 512, UNVERIFIED)                  \
+  DEVICE(ATmega48A, 0x1E, 0x92, 0x05, 4096, 512, RC_OSCILLATOR)                \
+  DEVICE(ATmega48PA, 0x1E, 0x92, 0x0A, 4096, 512, RC_OSCILLATOR)               \
+  DEVICE(ATmega88A, 0x1E, 0x93, 0x0A, 8192, 1024, RC_OSCILLATOR)               \
+  DEVICE(ATmega88PA, 0x1E, 0x93, 0x0F, 8192, 1024, RC_OSCILLATOR)              \
+  DEVICE(ATmega168A, 0x1E, 0x94, 0x06, 16384, 1024, RC_OSCILLATOR)             \
+  DEVICE(ATmega168PA, 0x1E, 0x94, 0x0B, 16384, 1024, RC_OSCILLATOR)            \
+  DEVICE(ATmega328, 0x1E, 0x95, 0x14, 32768, 2048, RC_OSCILLATOR)              \
+  DEVICE(ATmega328P, 0x1E, 0x95, 0x0F, 32768, 2048, RC_OSCILLATOR)             \
+  DEVICE(ATmega328PB, 0x1E, 0x95, 0x16, 32768, 2048, RC_OSCILLATOR)            \
+  DEVICE(ATmega164A, 0x1E, 0x94, 0x0F, 16384, 1024, UNVERIFIED)                \
+  DEVICE(ATmega164PA, 0x1E, 0x94, 0x0A, 16384, 1024, UNVERIFIED)               \
+  DEVICE(ATmega324A, 0x1E, 0x95, 0x15, 32768, 2048, UNVERIFIED)                \
+  DEVICE(ATmega324P, 0x1E, 0x95, 0x08, 32768, 2048, UNVERIFIED)                \
+  DEVICE(ATmega324PA, 0x1E, 0x95, 0x11, 32768, 2048, UNVERIFIED)               \
+  DEVICE(ATmega324PB, 0x1E, 0x95, 0x17, 32768, 2048, UNVERIFIED)               \
+  DEVICE(ATmega644A, 0x1E, 0x96, 0x09, 65536, 4096, UNVERIFIED)                \
+  DEVICE(ATmega644PA, 0x1E, 0x96, 0x0A, 65536, 4096, UNVERIFIED)               \
+  DEVICE(ATmega1284, 0x1E, 0x97, 0x06, 131072, 16384, UNVERIFIED)              \
+  DEVICE(ATmega1284P, 0x1E, 0x97, 0x05, 131072, 16384, UNVERIFIED)             \
+  DEVICE(ATmega640, 0x1E, 0x96, 0x08, 65536, 8192, UNVERIFIED)                 \
+  DEVICE(ATmega1280, 0x1E, 0x97, 0x03, 131072, 8192, UNVERIFIED)               \
+  DEVICE(ATmega1281, 0x1E, 0x97, 0x04, 131072, 8192, UNVERIFIED)               \
+  DEVICE(ATmega2560, 0x1E, 0x98, 0x01, 262144, 8192, UNVERIFIED)               \
+  DEVICE(ATmega2561, 0x1E, 0x98, 0x02, 262144, 8192, UNVERIFIED)               \
+  DEVICE(ATmega8U2, 0x1E, 0x93, 0x89, 8192, 512, UNVERIFIED)                   \
+  DEVICE(ATmega16U2, 0x1E, 0x94, 0x89, 16384, 512, UNVERIFIED)                 \
+  DEVICE(ATmega32U2, 0x1E, 0x95, 0x8A, 32768, 1024, UNVERIFIED)                \
+  DEVICE(ATmega16U4, 0x1E, 0x94, 0x88, 16384, 1280, UNVERIFIED)                \
+  DEVICE(ATmega32U4, 0x1E, 0x95, 0x87, 32768, 2560, UNVERIFIED)                \
+  DEVICE(ATtiny13, 0x1E, 0x90, 0x07, 1024, 64, UNVERIFIED)                     \
+  DEVICE(ATtiny2313, 0x1E, 0x91, 0x0A, 2048, 128, UNVERIFIED)                  \
+  DEVICE(ATtiny4313, 0x1E, 0x92, 0x0D, 4096, 256, UNVERIFIED)                  \
+  DEVICE(ATtiny24, 0x1E, 0x91, 0x0B, 2048, 128, RC_OSCILLATOR)                 \
+  DEVICE(ATtiny44, 0x1E, 0x92, 0x07, 4096, 256, RC_OSCILLATOR)                 \
+  DEVICE(ATtiny84, 0x1E, 0x93, 0x0C, 8192, 512, RC_OSCILLATOR)                 \
+  DEVICE(ATtiny25, 0x1E, 0x91, 0x08, 2048, 128, RC_OSCILLATOR)                 \
+  DEVICE(ATtiny45, 0x1E, 0x92, 0x06, 4096, 256, RC_OSCILLATOR)                 \
+  DEVICE(ATtiny85, 0x1E, 0x93, 0x0B, 8192, 512, RC_OSCILLATOR)                 \
+  DEVICE(ATtiny261, 0x1E, 0x91, 0x0C, 2048, 128, UNVERIFIED)                   \
+  DEVICE(ATtiny461, 0x1E, 0x92, 0x08, 4096, 256, UNVERIFIED)                   \
+  DEVICE(ATtiny861, 0x1E, 0x93, 0x0D, 8192, 512, UNVERIFIED)                   \
+  DEVICE(ATtiny48, 0x1E, 0x92, 0x09, 4096, 256, UNVERIFIED)                    \
+  DEVICE(ATtiny88, 0x1E, 0x93, 0x11, 8192, 512, UNVERIFIED)                    \
+  DEVICE(ATtiny87, 0x1E, 0x93, 0x87, 8192, 512, UNVERIFIED)                    \
+  DEVICE(ATtiny167, 0x1E, 0x94, 0x87, 16384, 512, UNVERIFIED)                  \
+  DEVICE(ATtiny441, 0x1E, 0x92, 0x15, 4096, 256, UNVERIFIED)                   \
+  DEVICE(ATtiny841, 0x1E, 0x93, 0x15, 8192, 512, UNVERIFIED)                   \
+  DEVICE(ATtiny828, 0x1E, 0x93, 0x14, 8192, 512, ATTINY828)                    \
+  DEVICE(ATtiny1634, 0x1E, 0x94, 0x12, 16384, 1024, UNVERIFIED)
+
+/*!
+ * @def SIGNATURE_ALIASES
+ * @brief List of devices, which share the signature (and the data) of an
+ *        entry of SIGNATURE_DEVICES.
+ *
+ * Every entry calls ALIAS(name, device) with the name of the entry in
+ * SIGNATURE_DEVICES. The signature can not tell them apart, so only the
+ * library, which is compiled for one device, reports the alias.
+ */
+#define SIGNATURE_ALIASES(ALIAS)                                               \
+  ALIAS(ATmega8A, ATmega8)                                                     \
+  ALIAS(ATmega16A, ATmega16)                                                   \
+  ALIAS(ATmega32A, ATmega32)                                                   \
+  ALIAS(ATmega64A, ATmega64)                                                   \
+  ALIAS(ATmega128A, ATmega128)                                                 \
+  ALIAS(ATmega48, ATmega48A)                                                   \
+  ALIAS(ATmega48P, ATmega48PA)                                                 \
+  ALIAS(ATmega88, ATmega88A)                                                   \
+  ALIAS(ATmega88P, ATmega88PA)                                                 \
+  ALIAS(ATmega168, ATmega168A)                                                 \
+  ALIAS(ATmega168P, ATmega168PA)                                               \
+  ALIAS(ATmega164P, ATmega164PA)                                               \
+  ALIAS(ATmega644, ATmega644A)                                                 \
+  ALIAS(ATmega644P, ATmega644PA)                                               \
+  ALIAS(ATtiny13A, ATtiny13)                                                   \
+  ALIAS(ATtiny2313A, ATtiny2313)                                               \
+  ALIAS(ATtiny24A, ATtiny24)                                                   \
+  ALIAS(ATtiny44A, ATtiny44)                                                   \
+  ALIAS(ATtiny84A, ATtiny84)                                                   \
+  ALIAS(ATtiny261A, ATtiny261)                                                 \
+  ALIAS(ATtiny461A, ATtiny461)                                                 \
+  ALIAS(ATtiny861A, ATtiny861)
+
+/*!
+ * @def SIGNATURE_LAYOUTS
+ * @brief List of all calibration layouts used by SIGNATURE_DEVICES.
+ */
+#define SIGNATURE_LAYOUTS(LAYOUT)                                              \
+  LAYOUT(NONE)                                                                 \
+  LAYOUT(UNVERIFIED)                                                           \
+  LAYOUT(RC_OSCILLATOR)                                                        \
+  LAYOUT(ATTINY828)
+
+/*!
+ * @def SIGNATURE_LAYOUT_NONE
+ * @brief Calibration layout of devices without additional features.
+ */
+#define SIGNATURE_LAYOUT_NONE(FIELD)
+
+/*!
+ * @def SIGNATURE_LAYOUT_UNVERIFIED
+ * @brief Calibration layout of devices, whose calibration bytes are not
+ *        verified yet. The library reads none of them, the host tools report
+ *        them as unknown (unlike NONE).
+ */
+#define SIGNATURE_LAYOUT_UNVERIFIED(FIELD)
+
+/*!
+ * @def SIGNATURE_LAYOUT_RC_OSCILLATOR
+ * @brief Calibration layout of devices with FEATURE_RC_OSCILLATOR_CALIBRATION.
+ *
+ * Every entry calls FIELD(index, address, label) with the index inside
+ * SignatureInfo, the address in the signature row and a readable label.
+ */
+#define SIGNATURE_LAYOUT_RC_OSCILLATOR(FIELD)                                  \
+  FIELD(RC_OSCILLATOR_CALIBRATION, 0x01, "RC Oscillator Calibration")
+
+/*!
+ * @def SIGNATURE_LAYOUT_ATTINY828
+ * @brief Calibration layout of the ATtiny828.
+ */
+#define SIGNATURE_LAYOUT_ATTINY828(FIELD)                                      \
+  FIELD(INTERNAL_8MHZ_OSCILLATOR_CALIBRATION, 0x01,                            \
+        "Internal 8MHz Oscillator Calibration (OSCCAL0)")                      \
+  FIELD(OSCILLATOR_TEMPERATURE_CALIBRATION_A, 0x03,                            \
+        "Oscillator Temperature Calibration Register A (OSCTCAL0A)")           \
+  FIELD(OSCILLATOR_TEMPERATURE_CALIBRATION_B, 0x05,                            \
+        "Oscillator Temperature Calibration Register B (OSCTCAL0B)")           \
+  FIELD(INTERNAL_32KHZ_OSCILLATOR_CALIBRATION, 0x07,                           \
+        "Internal 32kHz Oscillator Calibration (OSCCAL1)")                     \
+  FIELD(TEMPERATURE_SENSOR_GAIN_CALIBRATION, 0x2C,                             \
+        "Temperature Sensor Gain Calibration")                                 \
+  FIELD(TEMPERATURE_SENSOR_OFFSET_CALIBRATION, 0x2D,                           \
+        "Temperature Sensor Offset Calibration")
+
+/*!
+ * @def SIGNATURE_SUMMARY_TITLE
+ * @brief Text of the summary before the chip name, which is followed by
+ *        " (0x<signature>)".
+ */
+#define SIGNATURE_SUMMARY_TITLE "Signature Information:\n\tBoard: "
+/*!
+ * @def SIGNATURE_SUMMARY_FIELD
+ * @brief Text of the summary before the label of a calibration byte.
+ */
+#define SIGNATURE_SUMMARY_FIELD "\n\t"
+/*!
+ * @def SIGNATURE_SUMMARY_VALUE
+ * @brief Text of the summary between the label and the value (as hex without
+ *        leading zeros) of a calibration byte.
+ */
+#define SIGNATURE_SUMMARY_VALUE ": 0x"
+
+/*!
+ * @def SIGNATURE_BYTE_1_ADDRESS
+ * @brief Address of first signature byte
+ */
+#define SIGNATURE_BYTE_1_ADDRESS 0x00
+/*!
+ * @def SIGNATURE_BYTE_2_ADDRESS
+ * @brief Address of second signature byte
+ */
+#define SIGNATURE_BYTE_2_ADDRESS 0x02
+/*!
+ * @def SIGNATURE_BYTE_3_ADDRESS
+ * @brief Address of third signature byte
+ */
+#define SIGNATURE_BYTE_3_ADDRESS 0x04
+
+#endif // SIGNATURE_DEVICES_HPP
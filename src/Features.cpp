@@ -23,222 +23,292 @@
  * USA
  */
 
-#define FEATURE_RC_OSCILLATOR_CALIBRATION
-
 #include "Features.hpp"
+#include "SignatureInfo.hpp"
+#include "Devices.hpp"
 
-// Fix until https://github.com/avrdudes/avr-libc/issues/907 is fixed
-#if defined(__AVR_ATtiny24__) || defined(__AVR_ATtiny25__) ||                  \
-    defined(__AVR_ATtiny44__) || defined(__AVR_ATtiny45__) ||                  \
-    defined(__AVR_ATtiny84__) || defined(__AVR_ATtiny85__) ||                  \
-    defined(__AVR_ATtiny441__) || defined(__AVR_ATtiny828__) ||                \
-    defined(__AVR_ATtiny841__) || defined(__AVR_ATtiny1634__) ||               \
-    defined(__AVR_ATtiny4313__)
-#define SIGRD RSIG
-#endif
-
-#include <avr/boot.h>
+#include <avr/pgmspace.h>
 
 #if defined(CHAR_PTR_STRING)
-#include <avr/pgmspace.h>
 #define F(s) ((String)PSTR(s))
 #include <stdio.h>
 #include <stdlib.h>
-#include <string.h>
 #else
 #include <Print.h>
 #endif
 
-#ifdef FEATURE_RC_OSCILLATOR_CALIBRATION
-uint8_t Features::rcOscillatorCalibration = 0;
+#if defined(FEATURE_INTERNAL_8MHZ_OSCILLATOR_CALIBRATION)
+/*!
+ * @def SUMMARY_DICTIONARY
+ * @brief Store the labels of the summary as a dictionary of words.
+ *
+ * The six labels of the ATtiny828 repeat words like "Oscillator",
+ * "Temperature" and "Calibration", so a dictionary of the words (131 bytes),
+ * a list of word numbers (36 bytes) and the two separators (8 bytes) replace
+ * the strings of the fields (333 bytes of format strings, 321 bytes with
+ * F()). The decoder costs code instead; extras/SizeReport measures the net
+ * flash of both. Chips with a single label keep it as a plain string,
+ * because the decoder would cost more than it saves.
+ */
+#define SUMMARY_DICTIONARY
 #endif
 
-#ifdef FEATURE_INTERNAL_8MHZ_OSCILLATOR_CALIBRATION
-uint8_t Features::internal8MHzOscillatorCalibration = 0;
-#endif
+#ifdef SUMMARY_DICTIONARY
+/*!
+ * @def LAST_WORD
+ * @brief Mark of the last word of a label
+ */
+#define LAST_WORD 0x80
 
-#ifdef FEATURE_OSCILLATOR_TEMPERATURE_CALIBRATION_A
-uint8_t Features::oscillatorTemperatureCalibrationA = 0;
-#endif
+/*
+ * The words are separated by a space. A label is the index of its byte in
+ * SignatureInfo followed by the numbers of its words; the last number is
+ * marked with LAST_WORD.
+ */
 
-#ifdef FEATURE_OSCILLATOR_TEMPERATURE_CALIBRATION_B
-uint8_t Features::oscillatorTemperatureCalibrationB = 0;
-#endif
+/** Words of the labels */
+static constexpr char WORDS[] PROGMEM =
+    "Internal 8MHz Oscillator Calibration (OSCCAL0) Temperature Register A "
+    "(OSCTCAL0A) B (OSCTCAL0B) 32kHz (OSCCAL1) Sensor Gain Offset";
 
-#ifdef FEATURE_INTERNAL_32KHZ_OSCILLATOR_CALIBRATION
-uint8_t Features::internal32kHzOscillatorCalibration = 0;
-#endif
+/** Numbers of the words */
+enum Word : uint8_t {
+  WORD_INTERNAL,
+  WORD_MHZ_8,
+  WORD_OSCILLATOR,
+  WORD_CALIBRATION,
+  WORD_OSCCAL0,
+  WORD_TEMPERATURE,
+  WORD_REGISTER,
+  WORD_A,
+  WORD_OSCTCAL0A,
+  WORD_B,
+  WORD_OSCTCAL0B,
+  WORD_KHZ_32,
+  WORD_OSCCAL1,
+  WORD_SENSOR,
+  WORD_GAIN,
+  WORD_OFFSET
+};
 
-#ifdef FEATURE_TEMPERATURE_SENSOR_GAIN_CALIBRATION
-uint8_t Features::temperatureSensorGainCalibration = 0;
-#endif
+/** Labels in the order of FEATURE_LAYOUT */
+static constexpr uint8_t LABELS[] PROGMEM = {
+    SignatureInfo::INTERNAL_8MHZ_OSCILLATOR_CALIBRATION, WORD_INTERNAL,
+    WORD_MHZ_8, WORD_OSCILLATOR, WORD_CALIBRATION, WORD_OSCCAL0 | LAST_WORD,
+    SignatureInfo::OSCILLATOR_TEMPERATURE_CALIBRATION_A, WORD_OSCILLATOR,
+    WORD_TEMPERATURE, WORD_CALIBRATION, WORD_REGISTER, WORD_A,
+    WORD_OSCTCAL0A | LAST_WORD,
+    SignatureInfo::OSCILLATOR_TEMPERATURE_CALIBRATION_B, WORD_OSCILLATOR,
+    WORD_TEMPERATURE, WORD_CALIBRATION, WORD_REGISTER, WORD_B,
+    WORD_OSCTCAL0B | LAST_WORD,
+    SignatureInfo::INTERNAL_32KHZ_OSCILLATOR_CALIBRATION, WORD_INTERNAL,
+    WORD_KHZ_32, WORD_OSCILLATOR, WORD_CALIBRATION, WORD_OSCCAL1 | LAST_WORD,
+    SignatureInfo::TEMPERATURE_SENSOR_GAIN_CALIBRATION, WORD_TEMPERATURE,
+    WORD_SENSOR, WORD_GAIN, WORD_CALIBRATION | LAST_WORD,
+    SignatureInfo::TEMPERATURE_SENSOR_OFFSET_CALIBRATION, WORD_TEMPERATURE,
+    WORD_SENSOR, WORD_OFFSET, WORD_CALIBRATION | LAST_WORD};
 
-#ifdef FEATURE_TEMPERATURE_SENSOR_OFFSET_CALIBRATION
-uint8_t Features::temperatureSensorOffsetCalibration = 0;
-#endif
+/*!
+ * @brief Find a word of the dictionary (at compile time).
+ */
+static constexpr const char *findWord(const char *text, uint8_t word) {
+  return word == 0 ? text : findWord(text + 1, *text == ' ' ? word - 1 : word);
+}
 
-void Features::INIT() {
-#ifdef FEATURE_RC_OSCILLATOR_CALIBRATION
-#define RC_OSCILLATOR_CALIBRATION_BYTE 0x01
-  rcOscillatorCalibration =
-      boot_signature_byte_get(RC_OSCILLATOR_CALIBRATION_BYTE);
-#undef RC_OSCILLATOR_CALIBRATION_BYTE
-#endif
-#ifdef FEATURE_INTERNAL_8MHZ_OSCILLATOR_CALIBRATION
-#define INTERNAL_8MHZ_OSCILLATOR_CALIBRATION_BYTE 0x01
-  internal8MHzOscillatorCalibration =
-      boot_signature_byte_get(INTERNAL_8MHZ_OSCILLATOR_CALIBRATION_BYTE);
-#undef INTERNAL_8MHZ_OSCILLATOR_CALIBRATION_BYTE
-#endif
-#ifdef FEATURE_OSCILLATOR_TEMPERATURE_CALIBRATION_A
-#define OSCILLATOR_TEMPERATURE_CALIBRATION_A_BYTE 0x03
-  oscillatorTemperatureCalibrationA =
-      boot_signature_byte_get(OSCILLATOR_TEMPERATURE_CALIBRATION_A_BYTE);
-#undef OSCILLATOR_TEMPERATURE_CALIBRATION_A_BYTE
-#endif
-#ifdef FEATURE_OSCILLATOR_TEMPERATURE_CALIBRATION_B
-#define OSCILLATOR_TEMPERATURE_CALIBRATION_B_BYTE 0x05
-  oscillatorTemperatureCalibrationB =
-      boot_signature_byte_get(OSCILLATOR_TEMPERATURE_CALIBRATION_B_BYTE);
-#undef OSCILLATOR_TEMPERATURE_CALIBRATION_B_BYTE
-#endif
-#ifdef FEATURE_INTERNAL_32KHZ_OSCILLATOR_CALIBRATION
-#define INTERNAL_32KHZ_OSCILLATOR_CALIBRATION_BYTE 0x07
-  internal32kHzOscillatorCalibration =
-      boot_signature_byte_get(INTERNAL_32KHZ_OSCILLATOR_CALIBRATION_BYTE);
-#undef INTERNAL_32KHZ_OSCILLATOR_CALIBRATION_BYTE
-#endif
-#ifdef FEATURE_TEMPERATURE_SENSOR_GAIN_CALIBRATION
-#define TEMPERATURE_SENSOR_GAIN_CALIBRATION_BYTE 0x2C
-  temperatureSensorGainCalibration =
-      boot_signature_byte_get(TEMPERATURE_SENSOR_GAIN_CALIBRATION_BYTE);
-#undef TEMPERATURE_SENSOR_GAIN_CALIBRATION_BYTE
-#endif
-#ifdef FEATURE_TEMPERATURE_SENSOR_OFFSET_CALIBRATION
-#define TEMPERATURE_SENSOR_OFFSET_CALIBRATION_BYTE 0x2D
-  temperatureSensorOffsetCalibration =
-      boot_signature_byte_get(TEMPERATURE_SENSOR_OFFSET_CALIBRATION_BYTE);
-#undef TEMPERATURE_SENSOR_OFFSET_CALIBRATION_BYTE
-#endif
+/*!
+ * @brief Find a label of LABELS (at compile time). The indices are below
+ *        LAST_WORD, so every byte with LAST_WORD ends a label.
+ */
+static constexpr const uint8_t *findLabel(const uint8_t *label,
+                                          uint8_t number) {
+  return number == 0
+             ? label
+             : findLabel(label + 1, (*label & LAST_WORD) ? number - 1 : number);
 }
 
-String Features::getSummary() {
-#if defined(CHAR_PTR_STRING)
-  size_t size = 0;
-#else
-  String summary = F("");
-#endif
-#ifdef FEATURE_RC_OSCILLATOR_CALIBRATION
-  String stringRCOscillatorCalibration = F("\n\tRC Oscillator Calibration: 0x");
-#if defined(CHAR_PTR_STRING)
-  size += snprintf(nullptr, 0, "%s%X", stringRCOscillatorCalibration,
-                   rcOscillatorCalibration);
-#else
-  summary += stringRCOscillatorCalibration;
-  summary += String(rcOscillatorCalibration, HEX);
-#endif
-#endif
-#ifdef FEATURE_INTERNAL_8MHZ_OSCILLATOR_CALIBRATION
-  String stringInternal8MHZOscillatorCalibration =
-      F("\n\tInternal 8MHz Oscillator Calibration (OSCCAL0): 0x");
-#if defined(CHAR_PTR_STRING)
-  size += snprintf(nullptr, 0, "%s%X", stringInternal8MHZOscillatorCalibration,
-                   internal8MHzOscillatorCalibration);
-#else
-  summary += stringInternal8MHZOscillatorCalibration;
-  summary += String(internal8MHzOscillatorCalibration, HEX);
-#endif
-#endif
-#ifdef FEATURE_OSCILLATOR_TEMPERATURE_CALIBRATION_A
-  String stringOscillatorTemperatureCalibrationA =
-      F("\n\tOscillator Temperature Calibration Register A (OSCTCAL0A): 0x");
-#if defined(CHAR_PTR_STRING)
-  size += snprintf(nullptr, 0, "%s%X", stringOscillatorTemperatureCalibrationA,
-                   oscillatorTemperatureCalibrationA);
-#else
-  summary += stringOscillatorTemperatureCalibrationA;
-  summary += String(oscillatorTemperatureCalibrationA, HEX);
-#endif
-#endif
-#ifdef FEATURE_OSCILLATOR_TEMPERATURE_CALIBRATION_B
-  String stringOscillatorTemperatureCalibrationB =
-      F("\n\tOscillator Temperature Calibration Register B (OSCTCAL0B): 0x");
+/*!
+ * @brief Compare the expansion of the words of a label with a text (at
+ *        compile time).
+ */
+static constexpr bool expandsTo(const uint8_t *word, const char *character,
+                                const char *text) {
+  return (*character == ' ' || *character == '\0')
+             ? ((*word & LAST_WORD)
+                    ? *text == '\0'
+                    : *text == ' ' &&
+                          expandsTo(word + 1,
+                                    findWord(WORDS, word[1] & ~LAST_WORD),
+                                    text + 1))
+             : *character == *text && expandsTo(word, character + 1, text + 1);
+}
+
+/*!
+ * @brief Check a label against its index and text in Devices.hpp (at compile
+ *        time).
+ */
+static constexpr bool isLabel(const uint8_t *label, uint8_t index,
+                              const char *text) {
+  return label[0] == index &&
+         expandsTo(label + 1, findWord(WORDS, label[1] & ~LAST_WORD), text);
+}
+
+/** Position of the labels in FEATURE_LAYOUT */
+enum LabelNumber : uint8_t {
+#define LABEL_NUMBER(index, address, label) LABEL_##index,
+  FEATURE_LAYOUT(LABEL_NUMBER)
+#undef LABEL_NUMBER
+};
+
+// The dictionary has to expand to the labels of Devices.hpp, which are used by
+// the host tools.
+#define CHECK_LABEL(index, address, label)                                     \
+  static_assert(                                                               \
+      isLabel(findLabel(LABELS, LABEL_##index), SignatureInfo::index, label),  \
+      "The dictionary does not match the label of " #index);
+FEATURE_LAYOUT(CHECK_LABEL)
+#undef CHECK_LABEL
+
+/** Text before the label of a field. */
+static const char FIELD[] PROGMEM = SIGNATURE_SUMMARY_FIELD;
+/** Text between the label and the value of a field. */
+static const char VALUE[] PROGMEM = SIGNATURE_SUMMARY_VALUE;
+
+/** Output of expand(), called with every character of the summary. */
+typedef void (*Sink)(char character, void *context);
+
+/** Sink counting the characters (context: size_t). */
+static void count(char, void *context) { (*(size_t *)context)++; }
+
 #if defined(CHAR_PTR_STRING)
-  size += snprintf(nullptr, 0, "%s%X", stringOscillatorTemperatureCalibrationB,
-                   oscillatorTemperatureCalibrationB);
+/** Sink writing into a buffer (context: char *). */
+static void write(char character, void *context) {
+  *(*(char **)context)++ = character;
+}
 #else
-  summary += stringOscillatorTemperatureCalibrationB;
-  summary += String(oscillatorTemperatureCalibrationB, HEX);
-#endif
+/** Sink appending to a string (context: String). */
+static void append(char character, void *context) {
+  *(String *)context += character;
+}
 #endif
-#ifdef FEATURE_INTERNAL_32KHZ_OSCILLATOR_CALIBRATION
-  String stringInternal32KHZOscillatorCalibration =
-      F("\n\tInternal 32kHz Oscillator Calibration (OSCCAL1): 0x");
+
+/*!
+ * @brief Write a text from flash.
+ */
+static void writeText(const char *text, Sink sink, void *context) {
+  for (char character; (character = pgm_read_byte(text)) != '\0'; text++) {
+    sink(character, context);
+  }
+}
+
+/*!
+ * @brief Write a value as hex without leading zeros (like "%X" or HEX).
+ */
+static void writeHex(uint8_t value, Sink sink, void *context) {
 #if defined(CHAR_PTR_STRING)
-  size += snprintf(nullptr, 0, "%s%X", stringInternal32KHZOscillatorCalibration,
-                   internal32kHzOscillatorCalibration);
+  const char letters = 'A';
 #else
-  summary += stringInternal32KHZOscillatorCalibration;
-  summary += String(internal32kHzOscillatorCalibration, HEX);
-#endif
+  const char letters = 'a';
+#endif
+  for (uint8_t shift = value > 0x0F ? 4 : 0;; shift -= 4) {
+    uint8_t digit = (value >> shift) & 0x0F;
+    sink(digit < 10 ? '0' + digit : letters + digit - 10, context);
+    if (shift == 0) {
+      break;
+    }
+  }
+}
+
+/*!
+ * @brief Expand the labels and values of all fields into a sink.
+ */
+static void expand(const SignatureInfo &info, Sink sink, void *context) {
+  const uint8_t *label = LABELS;
+  while (label < LABELS + sizeof(LABELS)) {
+    uint8_t index = pgm_read_byte(label++);
+    writeText(FIELD, sink, context);
+    uint8_t word;
+    do {
+      word = pgm_read_byte(label++);
+      const char *character = WORDS;
+      for (uint8_t skip = word & ~LAST_WORD; skip > 0; character++) {
+        if (pgm_read_byte(character) == ' ') {
+          skip--;
+        }
+      }
+      for (char c; (c = pgm_read_byte(character)) != ' ' && c != '\0';
+           character++) {
+        sink(c, context);
+      }
+      if (!(word & LAST_WORD)) {
+        sink(' ', context);
+      }
+    } while (!(word & LAST_WORD));
+    writeText(VALUE, sink, context);
+    writeHex(info.getByte(index), sink, context);
+  }
+}
+#elif defined(CHAR_PTR_STRING)
+/*!
+ * @def FORMAT
+ * @brief Format of the summary of a field.
+ */
+#define FORMAT(index, address, label)                                          \
+  static const char FORMAT_##index[] PROGMEM =                                 \
+      SIGNATURE_SUMMARY_FIELD label SIGNATURE_SUMMARY_VALUE "%X";
+FEATURE_LAYOUT(FORMAT)
+#undef FORMAT
 #endif
-#ifdef FEATURE_TEMPERATURE_SENSOR_GAIN_CALIBRATION
-  String stringTemperatureSensorGainCalibration =
-      F("\n\tTemperature Sensor Gain Calibration: 0x");
+
+/*!
+ * @def FIELD_SIZE
+ * @brief Add the size of the summary of a field.
+ * @def FIELD_WRITE
+ * @brief Write the summary of a field.
+ * @def FIELD_APPEND
+ * @brief Append the summary of a field.
+ */
+String Features::getSummary(const SignatureInfo &info) {
+#ifdef SUMMARY_DICTIONARY
+  size_t size = 0;
+  expand(info, count, &size);
 #if defined(CHAR_PTR_STRING)
-  size += snprintf(nullptr, 0, "%s%X", stringTemperatureSensorGainCalibration,
-                   temperatureSensorGainCalibration);
+  auto summary = (String)malloc(sizeof(unsigned char) * size + 1);
+  char *position = (char *)summary;
+  expand(info, write, &position);
+  *position = '\0';
 #else
-  summary += stringTemperatureSensorGainCalibration;
-  summary += String(temperatureSensorGainCalibration, HEX);
-#endif
+  String summary = F("");
+  summary.reserve(size);
+  expand(info, append, &summary);
 #endif
-#ifdef FEATURE_TEMPERATURE_SENSOR_OFFSET_CALIBRATION
-  String stringTemperatureSensorOffsetCalibration =
-      F("\n\tTemperature Sensor Offset Calibration: 0x");
-#if defined(CHAR_PTR_STRING)
-  size += snprintf(nullptr, 0, "%s%X", stringTemperatureSensorOffsetCalibration,
-                   temperatureSensorOffsetCalibration);
 #else
-  summary += stringTemperatureSensorOffsetCalibration;
-  summary += String(temperatureSensorOffsetCalibration, HEX);
-#endif
-#endif
+  (void)info; // Unused if the chip has no additional features
 #if defined(CHAR_PTR_STRING)
+#define FIELD_SIZE(index, address, label)                                      \
+  size += snprintf_P(nullptr, 0, FORMAT_##index,                               \
+                     info.getByte(SignatureInfo::index));
+#define FIELD_WRITE(index, address, label)                                     \
+  position += sprintf_P(position, FORMAT_##index,                              \
+                        info.getByte(SignatureInfo::index));
+
+  size_t size = 0;
+  FEATURE_LAYOUT(FIELD_SIZE)
   auto summary = (String)malloc(sizeof(unsigned char) * size + 1);
-#ifdef FEATURE_RC_OSCILLATOR_CALIBRATION
-  sprintf((char *)summary, "%s%s%X", summary, stringRCOscillatorCalibration,
-          rcOscillatorCalibration);
-#endif
-#ifdef FEATURE_INTERNAL_8MHZ_OSCILLATOR_CALIBRATION
-  sprintf((char *)summary, "%s%s%X", summary,
-          stringInternal8MHZOscillatorCalibration,
-          internal8MHzOscillatorCalibration);
-#endif
-#ifdef FEATURE_OSCILLATOR_TEMPERATURE_CALIBRATION_A
-  sprintf((char *)summary, "%s%s%X", summary,
-          stringOscillatorTemperatureCalibrationA,
-          oscillatorTemperatureCalibrationA);
-#endif
-#ifdef FEATURE_OSCILLATOR_TEMPERATURE_CALIBRATION_B
-  sprintf((char *)summary, "%s%s%X", summary,
-          stringOscillatorTemperatureCalibrationB,
-          oscillatorTemperatureCalibrationB);
-#endif
-#ifdef FEATURE_INTERNAL_32KHZ_OSCILLATOR_CALIBRATION
-  sprintf((char *)summary, "%s%s%X", summary,
-          stringInternal32KHZOscillatorCalibration,
-          internal32kHzOscillatorCalibration);
-#endif
-#ifdef FEATURE_TEMPERATURE_SENSOR_GAIN_CALIBRATION
-  sprintf((char *)summary, "%s%s%X", summary,
-          stringTemperatureSensorGainCalibration,
-          temperatureSensorGainCalibration);
-#endif
-#ifdef FEATURE_TEMPERATURE_SENSOR_OFFSET_CALIBRATION
-  sprintf((char *)summary, "%s%s%X", summary,
-          stringTemperatureSensorOffsetCalibration,
-          temperatureSensorOffsetCalibration);
+  char *position = (char *)summary;
+  *position = '\0';
+  FEATURE_LAYOUT(FIELD_WRITE)
+
+#undef FIELD_WRITE
+#undef FIELD_SIZE
+#else
+#define FIELD_APPEND(index, address, label)                                    \
+  summary += F(SIGNATURE_SUMMARY_FIELD label SIGNATURE_SUMMARY_VALUE);         \
+  summary += String(info.getByte(SignatureInfo::index), HEX);
+
+  String summary = F("");
+  FEATURE_LAYOUT(FIELD_APPEND)
+
+#undef FIELD_APPEND
 #endif
 #endif
   return summary;
@@ -38,15 +38,24 @@ typedef unsigned char *String;
 #endif
 #endif
 
-#if defined(__AVR_ATmega48A__) || defined(__AVR_ATmega48PA__) ||               \
-    defined(__AVR_ATmega88A__) || defined(__AVR_ATmega88PA__) ||               \
-    defined(__AVR_ATmega168A__) || defined(__AVR_ATmega168PA__) ||             \
-    defined(__AVR_ATmega328__) || defined(__AVR_ATmega328P__)
+#if defined(__AVR_ATmega48__) || defined(__AVR_ATmega48A__) ||                \
+    defined(__AVR_ATmega48P__) || defined(__AVR_ATmega48PA__) ||               \
+    defined(__AVR_ATmega88__) || defined(__AVR_ATmega88A__) ||                 \
+    defined(__AVR_ATmega88P__) || defined(__AVR_ATmega88PA__) ||               \
+    defined(__AVR_ATmega168__) || defined(__AVR_ATmega168A__) ||               \
+    defined(__AVR_ATmega168P__) || defined(__AVR_ATmega168PA__) ||             \
+    defined(__AVR_ATmega328__) || defined(__AVR_ATmega328P__) ||               \
+    defined(__AVR_ATmega328PB__) || defined(__AVR_ATtiny24__) ||               \
+    defined(__AVR_ATtiny24A__) || defined(__AVR_ATtiny44__) ||                 \
+    defined(__AVR_ATtiny44A__) || defined(__AVR_ATtiny84__) ||                 \
+    defined(__AVR_ATtiny84A__) || defined(__AVR_ATtiny25__) ||                 \
+    defined(__AVR_ATtiny45__) || defined(__AVR_ATtiny85__)
 /*!
  * @def FEATURE_RC_OSCILLATOR_CALIBRATION
  * @brief Calibration data of the internal RC Oscillator (OSCCAL).
  */
 #define FEATURE_RC_OSCILLATOR_CALIBRATION
+#define FEATURE_LAYOUT SIGNATURE_LAYOUT_RC_OSCILLATOR
 #elif defined(__AVR_ATtiny828__)
 /*!
  * @def FEATURE_INTERNAL_8MHZ_OSCILLATOR_CALIBRATION
@@ -78,8 +87,37 @@ typedef unsigned char *String;
 #define FEATURE_INTERNAL_32KHZ_OSCILLATOR_CALIBRATION
 #define FEATURE_TEMPERATURE_SENSOR_GAIN_CALIBRATION
 #define FEATURE_TEMPERATURE_SENSOR_OFFSET_CALIBRATION
+#define FEATURE_LAYOUT SIGNATURE_LAYOUT_ATTINY828
 #endif
 
+#ifndef FEATURE_LAYOUT
+/*!
+ * @def FEATURE_LAYOUT
+ * @brief Calibration layout (see Devices.hpp) matching the FEATURE_* macros.
+ *
+ * The layout has to match the entry of the target in Devices.hpp, which is
+ * checked at compile time (see Signature.cpp).
+ */
+#define FEATURE_LAYOUT SIGNATURE_LAYOUT_UNVERIFIED
+#endif
+
+/*!
+ * @brief   Additional information, which can be stored in the signature of the
+ *          microcontroller. Which of them are available is a compile time
+ *          property (see Signature::has()).
+ */
+enum class Feature : uint8_t {
+  RcOscillatorCalibration,            /// Internal RC oscillator (OSCCAL).
+  Internal8MHzOscillatorCalibration,  /// Internal 8MHz oscillator (OSCCAL0).
+  OscillatorTemperatureCalibrationA,  /// Temperature register A (OSCTCAL0A).
+  OscillatorTemperatureCalibrationB,  /// Temperature register B (OSCTCAL0B).
+  Internal32kHzOscillatorCalibration, /// Internal 32kHz oscillator (OSCCAL1).
+  TemperatureSensorGainCalibration,   /// Temperature sensor (gain).
+  TemperatureSensorOffsetCalibration, /// Temperature sensor (offset).
+};
+
+class SignatureInfo;
+
 /*!
  * @brief   Class representing additional information stored in the signature of
  * the microcontroller
@@ -88,108 +126,17 @@ typedef unsigned char *String;
  * implementation
  */
 class Features {
-private:
-#ifdef FEATURE_RC_OSCILLATOR_CALIBRATION
-  static uint8_t rcOscillatorCalibration; /// Factory calibration value of the
-                                          /// internal RC oscillator.
-#endif
-#ifdef FEATURE_INTERNAL_8MHZ_OSCILLATOR_CALIBRATION
-  static uint8_t internal8MHzOscillatorCalibration; /// Factory calibration
-                                                    /// value of the internal
-                                                    /// 8MHz oscillator
-#endif
-#ifdef FEATURE_OSCILLATOR_TEMPERATURE_CALIBRATION_A
-  static uint8_t oscillatorTemperatureCalibrationA; /// Factory calibration
-                                                    /// value of the Oscillator
-                                                    /// Temperature Calibration
-                                                    /// Register A (OSCTCAL0A)
-#endif
-#ifdef FEATURE_OSCILLATOR_TEMPERATURE_CALIBRATION_B
-  static uint8_t oscillatorTemperatureCalibrationB; /// Factory calibration
-                                                    /// value of the Oscillator
-                                                    /// Temperature Calibration
-                                                    /// Register B (OSCTCAL0B)
-#endif
-#ifdef FEATURE_INTERNAL_32KHZ_OSCILLATOR_CALIBRATION
-  static uint8_t internal32kHzOscillatorCalibration; /// Factory calibration
-                                                     /// value of the internal
-                                                     /// 32kHz oscillator
-#endif
-#ifdef FEATURE_TEMPERATURE_SENSOR_GAIN_CALIBRATION
-  static uint8_t temperatureSensorGainCalibration; /// Factory calibration value
-                                                   /// of the temperature sensor
-                                                   /// (gain)
-#endif
-#ifdef FEATURE_TEMPERATURE_SENSOR_OFFSET_CALIBRATION
-  static uint8_t temperatureSensorOffsetCalibration; /// Factory calibration
-                                                     /// value of the
-                                                     /// temperature sensor
-                                                     /// (offset)
-#endif
 public:
-  /*!
-   * @brief Initialise the class
-   */
-  static void INIT();
-
-#ifdef FEATURE_RC_OSCILLATOR_CALIBRATION
-  static uint8_t getRcOscillatorCalibration() {
-    INIT();
-    return rcOscillatorCalibration;
-  }
-#endif
-
-#ifdef FEATURE_INTERNAL_8MHZ_OSCILLATOR_CALIBRATION
-  static uint8_t getInternal8MHzOscillatorCalibration() {
-    INIT();
-    return internal8MHzOscillatorCalibration;
-  }
-#endif
-
-#ifdef FEATURE_OSCILLATOR_TEMPERATURE_CALIBRATION_A
-  static uint8_t getOscillatorTemperatureCalibrationA() {
-    INIT();
-    return oscillatorTemperatureCalibrationA;
-  }
-#endif
-
-#ifdef FEATURE_OSCILLATOR_TEMPERATURE_CALIBRATION_B
-  static uint8_t getOscillatorTemperatureCalibrationB() {
-    INIT();
-    return oscillatorTemperatureCalibrationB;
-  }
-#endif
-
-#ifdef FEATURE_INTERNAL_32KHZ_OSCILLATOR_CALIBRATION
-  static uint8_t getInternal32kHzOscillatorCalibration() {
-    INIT();
-    return internal32kHzOscillatorCalibration;
-  }
-#endif
-
-#ifdef FEATURE_TEMPERATURE_SENSOR_GAIN_CALIBRATION
-  static uint8_t getTemperatureSensorGainCalibration() {
-    INIT();
-    return temperatureSensorGainCalibration;
-  }
-#endif
-
-#ifdef FEATURE_TEMPERATURE_SENSOR_OFFSET_CALIBRATION
-  static uint8_t getTemperatureSensorOffsetCalibration() {
-    INIT();
-    return temperatureSensorOffsetCalibration;
-  }
-#endif
-
   /*!
    * @brief Writing a summary of the additional information stored in the
    *        signature of the microcontroller.
    *
+   * @param info    Snapshot of the signature row to summarise.
    * @return    A string containing a summary of the additional information.
    * @note  If NOT using the arduino framework, the returned pointer has to be
    *        free'd with free() in order to prevent memory leaks.
    */
-  static String getSummary();
+  static String getSummary(const SignatureInfo &info);
 };
 
 #endif // SIGNATURE_FEATURES_H
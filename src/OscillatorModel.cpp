@@ -0,0 +1,78 @@
+/*!
+ * @file OscillatorModel.cpp
+ *
+ * This file is part of the Signature library. It gives easy access to the
+ * signature of AVR microcontrollers. The library contains functions that
+ * provides the information of the signature bytes.
+ *
+ * Copyright (C) 2022-2023  Niklas Kaaf
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ * USA
+ */
+
+#include "OscillatorModel.hpp"
+
+/*!
+ * @def TEMPERATURE_SENSOR_ZERO
+ * @brief ADC value of the temperature sensor at 25°C without offset.
+ */
+#define TEMPERATURE_SENSOR_ZERO (273 + 100)
+
+uint16_t OscillatorModel::toScale(uint8_t gain) {
+  if (gain == 0) {
+    gain = 128;
+  }
+  return (uint16_t)(((uint32_t)128 << 8) + gain / 2) / gain;
+}
+
+int16_t OscillatorModel::toTemperature(uint16_t adc, uint16_t scale,
+                                       uint8_t offset) {
+  // T = (ADC - (273 + 100 - TS_OFFSET)) * 128 / TS_GAIN + 25, with the signed
+  // offset and the gain in units of 1/128. The division by the gain is a
+  // multiplication with its reciprocal (rounded to the nearest integer).
+  int16_t difference =
+      (int16_t)adc - (TEMPERATURE_SENSOR_ZERO - (int8_t)offset);
+  return (int16_t)(((int32_t)difference * scale + 0x80) >> 8) + 25;
+}
+
+uint16_t OscillatorModel::toAdc(int16_t temperature, uint8_t gain,
+                                uint8_t offset) {
+  if (gain == 0) {
+    gain = 128;
+  }
+  int32_t adc = ((int32_t)temperature - 25) * gain / 128 +
+                (TEMPERATURE_SENSOR_ZERO - (int8_t)offset);
+  if (adc < 0) {
+    return 0;
+  }
+  if (adc > 0x3FF) {
+    return 0x3FF;
+  }
+  return (uint16_t)adc;
+}
+
+uint8_t OscillatorModel::toCalibration(int16_t temperature, uint8_t factory,
+                                       int8_t coefficient) {
+  int16_t calibration =
+      factory + (int16_t)((int32_t)coefficient * (temperature - 25) / 16);
+  if (calibration < 0) {
+    return 0;
+  }
+  if (calibration > 0xFF) {
+    return 0xFF;
+  }
+  return (uint8_t)calibration;
+}
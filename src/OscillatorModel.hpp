@@ -0,0 +1,100 @@
+/*!
+ * @file OscillatorModel.hpp
+ *
+ * This file is part of the Signature library. It gives easy access to the
+ * signature of AVR microcontrollers. The library contains functions that
+ * provides the information of the signature bytes.
+ *
+ * Copyright (C) 2022-2023  Niklas Kaaf
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ * USA
+ */
+
+#ifndef SIGNATURE_OSCILLATOR_MODEL_HPP
+#define SIGNATURE_OSCILLATOR_MODEL_HPP
+
+#include <stdint.h>
+
+/*!
+ * @brief   Computations of the oscillator temperature compensation (see
+ *          OscillatorTrim).
+ *
+ * They do not access any register, so they are available on every target
+ * and can also be compiled on the host, e.g. to simulate the compensation
+ * with a scripted temperature profile (see extras/OscillatorSimulation).
+ */
+class OscillatorModel {
+public:
+  /*!
+   * @brief Compute the reciprocal of the factory gain of the temperature
+   *        sensor, so that toTemperature() needs no division.
+   *
+   * @param gain    Factory gain of the temperature sensor.
+   * @return    128 / gain as a fixed point value with 8 fractional bits.
+   */
+  static uint16_t toScale(uint8_t gain);
+
+  /*!
+   * @brief Convert a reading of the temperature sensor (1.1V reference).
+   *
+   * @param adc     ADC value of the temperature sensor.
+   * @param scale   Reciprocal of the factory gain (see toScale()).
+   * @param offset  Factory offset of the temperature sensor.
+   * @return    Temperature in °C.
+   */
+  static int16_t toTemperature(uint16_t adc, uint16_t scale, uint8_t offset);
+
+  /*!
+   * @brief Compute the reading of the temperature sensor for a temperature
+   *        (inverse of toTemperature()).
+   *
+   * @param temperature Temperature in °C.
+   * @param gain        Factory gain of the temperature sensor.
+   * @param offset      Factory offset of the temperature sensor.
+   * @return    ADC value of the temperature sensor.
+   */
+  static uint16_t toAdc(int16_t temperature, uint8_t gain, uint8_t offset);
+
+  /*!
+   * @brief Compute the OSCCAL0 value for a temperature.
+   *
+   * @param temperature Temperature in °C.
+   * @param factory     Factory calibration of OSCCAL0.
+   * @param coefficient OSCCAL0 steps per 16°C.
+   * @return    Target calibration value.
+   */
+  static uint8_t toCalibration(int16_t temperature, uint8_t factory,
+                               int8_t coefficient);
+
+  /*!
+   * @brief Move a calibration value one step towards a target.
+   *
+   * @param current Current calibration value.
+   * @param target  Target calibration value.
+   * @return    Next calibration value.
+   */
+  static uint8_t step(uint8_t current, uint8_t target) {
+    if (current < target) {
+      return current + 1;
+    }
+    if (current > target) {
+      return current - 1;
+    }
+    return current;
+  }
+};
+
+#endif // SIGNATURE_OSCILLATOR_MODEL_HPP
@@ -0,0 +1,106 @@
+/*!
+ * @file OscillatorTrim.cpp
+ *
+ * This file is part of the Signature library. It gives easy access to the
+ * signature of AVR microcontrollers. The library contains functions that
+ * provides the information of the signature bytes.
+ *
+ * Copyright (C) 2022-2023  Niklas Kaaf
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ * USA
+ */
+
+#include "OscillatorTrim.hpp"
+
+#ifdef FEATURE_OSCILLATOR_TRIM
+
+#include "Signature.hpp"
+
+#include <avr/io.h>
+
+OscillatorTrim::State OscillatorTrim::state = OscillatorTrim::IDLE;
+uint32_t OscillatorTrim::interval = 0;
+uint32_t OscillatorTrim::since = 0;
+int8_t OscillatorTrim::coefficient = 0;
+uint8_t OscillatorTrim::factory = 0;
+uint16_t OscillatorTrim::scale = 0;
+uint8_t OscillatorTrim::offset = 0;
+uint8_t OscillatorTrim::target = 0;
+int16_t OscillatorTrim::temperature = 25;
+
+void OscillatorTrim::begin(int8_t coefficient, uint32_t interval) {
+  SignatureInfo info = Signature::getInfo();
+
+  ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+    OscillatorTrim::coefficient = coefficient;
+    OscillatorTrim::interval = interval;
+    factory = info.getInternal8MHzOscillatorCalibration();
+    scale = OscillatorModel::toScale(
+        info.getTemperatureSensorGainCalibration());
+    offset = info.getTemperatureSensorOffsetCalibration();
+    target = OSCCAL0;
+    state = SELECTING;
+  }
+}
+
+void OscillatorTrim::update(uint32_t now) {
+  switch (state) {
+  case IDLE:
+    if (now - since < interval) {
+      break;
+    }
+    // fall through
+  case SELECTING:
+    ADMUXA = OSCILLATOR_TRIM_TEMPERATURE_CHANNEL;
+    ADMUXB = _BV(REFS);
+    ADCSRA = _BV(ADEN) | OSCILLATOR_TRIM_ADC_PRESCALER;
+    since = now;
+    state = SETTLING;
+    break;
+  case SETTLING:
+    if (now - since <= OSCILLATOR_TRIM_SETTLING_TIME) {
+      break;
+    }
+    ADCSRA |= _BV(ADSC);
+    state = DISCARDING;
+    break;
+  case DISCARDING:
+    // The first conversion after selecting the reference is not accurate.
+    if (ADCSRA & _BV(ADSC)) {
+      break;
+    }
+    ADCSRA |= _BV(ADSC);
+    state = CONVERTING;
+    break;
+  case CONVERTING:
+    if (ADCSRA & _BV(ADSC)) {
+      break;
+    }
+    temperature = OscillatorModel::toTemperature(ADC, scale, offset);
+    ADCSRA &= ~_BV(ADEN);
+    target = OscillatorModel::toCalibration(temperature, factory, coefficient);
+    since = now;
+    state = IDLE;
+    break;
+  }
+
+  uint8_t calibration = OSCCAL0;
+  if (calibration != target) {
+    OSCCAL0 = OscillatorModel::step(calibration, target);
+  }
+}
+
+#endif // FEATURE_OSCILLATOR_TRIM
@@ -0,0 +1,170 @@
+/*!
+ * @file OscillatorTrim.hpp
+ *
+ * This file is part of the Signature library. It gives easy access to the
+ * signature of AVR microcontrollers. The library contains functions that
+ * provides the information of the signature bytes.
+ *
+ * Copyright (C) 2022-2023  Niklas Kaaf
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ * USA
+ */
+
+#ifndef SIGNATURE_OSCILLATOR_TRIM_HPP
+#define SIGNATURE_OSCILLATOR_TRIM_HPP
+
+#include "Features.hpp"
+#include "OscillatorModel.hpp"
+
+#if defined(FEATURE_INTERNAL_8MHZ_OSCILLATOR_CALIBRATION) &&                   \
+    defined(FEATURE_TEMPERATURE_SENSOR_GAIN_CALIBRATION) &&                    \
+    defined(FEATURE_TEMPERATURE_SENSOR_OFFSET_CALIBRATION)
+/*!
+ * @def FEATURE_OSCILLATOR_TRIM
+ * @brief Temperature compensation of the internal 8MHz oscillator (OSCCAL0).
+ */
+#define FEATURE_OSCILLATOR_TRIM
+#endif
+
+#ifdef FEATURE_OSCILLATOR_TRIM
+
+#include <util/atomic.h>
+
+#ifndef OSCILLATOR_TRIM_TEMPERATURE_CHANNEL
+/*!
+ * @def OSCILLATOR_TRIM_TEMPERATURE_CHANNEL
+ * @brief ADMUXA value selecting the internal temperature sensor. Can be
+ *        defined before including this file.
+ */
+#define OSCILLATOR_TRIM_TEMPERATURE_CHANNEL 0x1D
+#endif
+
+#ifndef OSCILLATOR_TRIM_SETTLING_TIME
+/*!
+ * @def OSCILLATOR_TRIM_SETTLING_TIME
+ * @brief Time in milliseconds, which the 1.1V reference and the multiplexer
+ *        get to settle before the first conversion. The actual time is longer
+ *        by up to one millisecond. Can be defined before including this file.
+ */
+#define OSCILLATOR_TRIM_SETTLING_TIME 1
+#endif
+
+#ifndef OSCILLATOR_TRIM_ADC_PRESCALER
+#if !defined(F_CPU) || F_CPU > 6400000UL
+/*!
+ * @def OSCILLATOR_TRIM_ADC_PRESCALER
+ * @brief ADPS bits of ADCSRA while sampling. The default keeps the ADC clock
+ *        within 50kHz to 200kHz for F_CPU (division factor 128 if F_CPU is
+ *        not known). Can be defined before including this file.
+ */
+#define OSCILLATOR_TRIM_ADC_PRESCALER (_BV(ADPS2) | _BV(ADPS1) | _BV(ADPS0))
+#elif F_CPU > 3200000UL
+#define OSCILLATOR_TRIM_ADC_PRESCALER (_BV(ADPS2) | _BV(ADPS1))
+#elif F_CPU > 1600000UL
+#define OSCILLATOR_TRIM_ADC_PRESCALER (_BV(ADPS2) | _BV(ADPS0))
+#elif F_CPU > 800000UL
+#define OSCILLATOR_TRIM_ADC_PRESCALER _BV(ADPS2)
+#else
+#define OSCILLATOR_TRIM_ADC_PRESCALER (_BV(ADPS1) | _BV(ADPS0))
+#endif
+#endif
+
+/*!
+ * @brief   Class compensating the temperature drift of the internal 8MHz
+ *          oscillator in the background.
+ *
+ * Every update() does one small step: it either selects the temperature
+ * sensor, starts or collects one ADC conversion, or moves OSCCAL0 by one
+ * towards the target. Nothing waits for the ADC, so update() can be called
+ * from loop() or from a timer interrupt.
+ *
+ * Every sample enables the ADC, lets the reference settle, discards the first
+ * conversion and disables the ADC again after the second one, so the ADC is
+ * only powered while sampling.
+ *
+ * The temperature is computed with the factory gain and offset of the
+ * temperature sensor. The target is the factory OSCCAL0 value corrected by a
+ * linear coefficient around 25°C (see OscillatorModel):
+ *
+ *    target = OSCCAL0(factory) + coefficient * (T - 25°C) / 16
+ *
+ * The datasheet does not document a software model for the factory values of
+ * OSCTCAL0A/OSCTCAL0B (they are used by the hardware), so the coefficient has
+ * to be characterised for the application.
+ *
+ * @note    The ADC is used while a sample is taken. Applications which use the
+ *          ADC themselves have to call update() only when it is free.
+ */
+class OscillatorTrim {
+private:
+  /** Step of the background state machine. */
+  enum State : uint8_t { IDLE, SELECTING, SETTLING, DISCARDING, CONVERTING };
+
+  static State state;         /// Current step of the state machine.
+  static uint32_t interval;   /// Time between two samples in milliseconds.
+  static uint32_t since;      /// Start of the current wait in milliseconds.
+  static int8_t coefficient;  /// OSCCAL0 steps per 16°C.
+  static uint8_t factory;     /// Factory calibration of OSCCAL0.
+  static uint16_t scale;      /// Reciprocal of the factory gain.
+  static uint8_t offset;      /// Factory offset of the temperature sensor.
+  static uint8_t target;      /// OSCCAL0 value to reach.
+  static int16_t temperature; /// Last measured temperature in °C.
+
+public:
+  /*!
+   * @brief Start the compensation. The first sample is taken by the next
+   *        update().
+   *
+   * @param coefficient Change of OSCCAL0 (in steps) per 16°C above 25°C.
+   * @param interval    Time between two temperature samples in milliseconds.
+   */
+  static void begin(int8_t coefficient, uint32_t interval);
+
+  /*!
+   * @brief Do one step of the compensation. Only the step that collects a
+   *        sample computes something: two multiplications (the gain is
+   *        inverted once by begin(), so there is no division at runtime).
+   *
+   * @param now Current time in milliseconds, e.g. millis().
+   */
+  static void update(uint32_t now);
+
+  /*!
+   * @brief Get the last measured temperature.
+   *
+   * @return    Temperature in °C.
+   */
+  static int16_t getTemperature() {
+    int16_t value;
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) { value = temperature; }
+    return value;
+  }
+
+  /*!
+   * @brief Get the value OSCCAL0 is moved to.
+   *
+   * @return    Target calibration value.
+   */
+  static uint8_t getTarget() {
+    uint8_t value;
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) { value = target; }
+    return value;
+  }
+};
+
+#endif // FEATURE_OSCILLATOR_TRIM
+
+#endif // SIGNATURE_OSCILLATOR_TRIM_HPP
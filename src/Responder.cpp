@@ -0,0 +1,124 @@
+/*!
+ * @file Responder.cpp
+ *
+ * This file is part of the Signature library. It gives easy access to the
+ * signature of AVR microcontrollers. The library contains functions that
+ * provides the information of the signature bytes.
+ *
+ * Copyright (C) 2022-2023  Niklas Kaaf
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ * USA
+ */
+
+#include "Responder.hpp"
+
+#if defined(__AVR__) && defined(TWDR)
+#include <util/twi.h>
+#endif
+
+SignatureInfo Responder::info;
+volatile uint8_t Responder::header = 0xFF;
+volatile uint8_t Responder::position = 0;
+volatile uint8_t Responder::end = 0;
+
+void Responder::begin(const SignatureInfo &snapshot) {
+  info = snapshot;
+  header = 0xFF;
+  position = 0;
+  end = 0;
+}
+
+void Responder::query(uint8_t query) {
+  uint8_t first = 0;
+  uint8_t last = 0;
+  if (query == SIGNATURE) {
+    first = SignatureInfo::SIGNATURE_BYTE_1;
+    last = SignatureInfo::SIGNATURE_BYTE_3 + 1;
+  } else if (query == RECORD) {
+    last = SignatureInfo::SIZE;
+  } else if ((query & 0xF0) == CALIBRATION) {
+    first = SignatureInfo::SIGNATURE_BYTE_3 + 1 + (query & 0x0F);
+    last = first < SignatureInfo::SIZE ? first + 1 : first;
+  }
+  position = first;
+  end = last;
+  header = last - first;
+}
+
+uint8_t Responder::next() {
+  if (header != 0xFF) {
+    uint8_t length = header;
+    header = 0xFF;
+    return length;
+  }
+  if (position < end) {
+    return info.getByte(position++);
+  }
+  return 0;
+}
+
+#if defined(__AVR__) && defined(UDR0)
+void Responder::beginUart(uint16_t ubrr) {
+  UBRR0 = ubrr;
+  UCSR0A = 0;
+  UCSR0C = _BV(UCSZ01) | _BV(UCSZ00);
+  UCSR0B = _BV(RXEN0) | _BV(TXEN0) | _BV(RXCIE0);
+}
+
+void Responder::handleUartReceive() {
+  query(UDR0);
+  UCSR0B |= _BV(UDRIE0);
+}
+
+void Responder::handleUartEmpty() {
+  if (available()) {
+    UDR0 = next();
+  } else {
+    UCSR0B &= ~_BV(UDRIE0);
+  }
+}
+#endif
+
+#if defined(__AVR__) && defined(TWDR)
+void Responder::beginTwi(uint8_t address) {
+  TWAR = address << 1;
+  TWCR = _BV(TWEA) | _BV(TWEN) | _BV(TWIE);
+}
+
+void Responder::handleTwi() {
+  uint8_t control = _BV(TWINT) | _BV(TWEA) | _BV(TWEN) | _BV(TWIE);
+  switch (TW_STATUS) {
+  case TW_SR_DATA_ACK:
+    query(TWDR);
+    break;
+  case TW_ST_SLA_ACK:
+  case TW_ST_DATA_ACK:
+    TWDR = next();
+    if (!available()) {
+      // Last byte of the answer: the master has to answer it with a NACK.
+      control &= ~_BV(TWEA);
+    }
+    break;
+  case TW_BUS_ERROR:
+    // Release the bus. In slave mode no STOP is sent, only the TWI is reset.
+    control |= _BV(TWSTO);
+    break;
+  default:
+    break;
+  }
+  TWCR = control;
+}
+#endif
@@ -0,0 +1,165 @@
+/*!
+ * @file Responder.hpp
+ *
+ * This file is part of the Signature library. It gives easy access to the
+ * signature of AVR microcontrollers. The library contains functions that
+ * provides the information of the signature bytes.
+ *
+ * Copyright (C) 2022-2023  Niklas Kaaf
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ * USA
+ */
+
+#ifndef SIGNATURE_RESPONDER_HPP
+#define SIGNATURE_RESPONDER_HPP
+
+#include "Signature.hpp"
+
+#if defined(__AVR__)
+#include <avr/interrupt.h>
+#include <avr/io.h>
+#endif
+
+/*!
+ * @brief   Class answering binary queries of a bus master for the signature
+ *          from within the interrupts of the UART or the TWI (I2C).
+ *
+ * A query is one byte, the answer is a length byte followed by the data:
+ *
+ *    SIGNATURE           -> [3] [sig1] [sig2] [sig3]
+ *    CALIBRATION | n     -> [1] [calibration byte n] (n < 16)
+ *    RECORD              -> [SignatureInfo::SIZE] [all bytes of SignatureInfo]
+ *    unknown             -> [0]
+ *
+ * The answer is sent directly from the cached SignatureInfo, so no buffer, no
+ * heap and no work outside of the interrupts is needed. The transport only
+ * has to pass every received byte to query() and send next() while
+ * available() is true. SIGNATURE_RESPONDER_UART_ISR() and
+ * SIGNATURE_RESPONDER_TWI_ISR() define the interrupts for the USART0 and the
+ * TWI of the ATmega48-328 family. The transports only exist on the AVR, the
+ * protocol (query(), available(), next()) also compiles on the host.
+ *
+ * The UART is point-to-point: there is no node address, every received byte
+ * is a query and is answered. Several nodes on one bus are queried over the
+ * TWI, where every node has its own slave address.
+ *
+ * @note    The interrupts must not be used by other code (e.g. Serial or
+ *          Wire) at the same time.
+ */
+class Responder {
+public:
+  /** First byte of a query. */
+  enum Query : uint8_t {
+    SIGNATURE = 0x01,  /// The three signature bytes.
+    RECORD = 0x02,     /// All bytes of SignatureInfo.
+    CALIBRATION = 0x10 /// Calibration byte n (lower nibble).
+  };
+
+private:
+  static SignatureInfo info;        /// Snapshot the answers are sent from.
+  static volatile uint8_t header;   /// Length byte, 0xFF if already sent.
+  static volatile uint8_t position; /// Next byte of the snapshot to send.
+  static volatile uint8_t end;      /// End of the answer in the snapshot.
+
+public:
+  /*!
+   * @brief Cache the signature of the microcontroller. Has to be called before
+   *        the interrupts are enabled.
+   */
+  static void begin() { begin(Signature::getInfo()); }
+
+  /*!
+   * @brief Cache a snapshot, e.g. a synthetic one for tests on the host.
+   *
+   * @param snapshot    Snapshot to answer from.
+   */
+  static void begin(const SignatureInfo &snapshot);
+
+  /*!
+   * @brief Handle a received query. Replaces an answer not sent completely.
+   *
+   * @param query   Received query byte.
+   */
+  static void query(uint8_t query);
+
+  /*!
+   * @brief Check if bytes of the answer are left.
+   *
+   * @return    True, if next() returns a byte of the answer.
+   */
+  static bool available() { return header != 0xFF || position < end; }
+
+  /*!
+   * @brief Get the next byte of the answer.
+   *
+   * @return    The next byte, or 0 if the answer has been sent completely.
+   */
+  static uint8_t next();
+
+#if defined(__AVR__) && defined(UDR0)
+  /*!
+   * @brief Configure USART0 (8N1) for the responder. The UART has no node
+   *        addressing, so only one node may be connected to the master.
+   *
+   * @param ubrr    Value of the baud rate register (UBRR0).
+   */
+  static void beginUart(uint16_t ubrr);
+
+  /*!
+   * @brief Handle the USART0 receive interrupt.
+   */
+  static void handleUartReceive();
+
+  /*!
+   * @brief Handle the USART0 data register empty interrupt.
+   */
+  static void handleUartEmpty();
+#endif
+
+#if defined(__AVR__) && defined(TWDR)
+  /*!
+   * @brief Configure the TWI as a slave for the responder.
+   *
+   * @param address 7-bit slave address.
+   */
+  static void beginTwi(uint8_t address);
+
+  /*!
+   * @brief Handle the TWI interrupt.
+   */
+  static void handleTwi();
+#endif
+};
+
+#if defined(__AVR__)
+/*!
+ * @def SIGNATURE_RESPONDER_UART_ISR
+ * @brief Define the USART0 interrupts for the responder. Use it once in the
+ *        sketch.
+ */
+#define SIGNATURE_RESPONDER_UART_ISR()                                         \
+  ISR(USART_RX_vect) { Responder::handleUartReceive(); }                       \
+  ISR(USART_UDRE_vect) { Responder::handleUartEmpty(); }
+
+/*!
+ * @def SIGNATURE_RESPONDER_TWI_ISR
+ * @brief Define the TWI interrupt for the responder. Use it once in the sketch.
+ */
+#define SIGNATURE_RESPONDER_TWI_ISR()                                          \
+  ISR(TWI_vect) { Responder::handleTwi(); }
+#endif
+
+#endif // SIGNATURE_RESPONDER_HPP
@@ -24,18 +24,9 @@
  */
 
 #include "Signature.hpp"
+#include "Devices.hpp"
 
-// Fix until https://github.com/avrdudes/avr-libc/issues/907 is fixed
-#if defined(__AVR_ATtiny24__) || defined(__AVR_ATtiny25__) ||                  \
-    defined(__AVR_ATtiny44__) || defined(__AVR_ATtiny45__) ||                  \
-    defined(__AVR_ATtiny84__) || defined(__AVR_ATtiny85__) ||                  \
-    defined(__AVR_ATtiny441__) || defined(__AVR_ATtiny828__) ||                \
-    defined(__AVR_ATtiny841__) || defined(__AVR_ATtiny1634__) ||               \
-    defined(__AVR_ATtiny4313__)
-#define SIGRD RSIG
-#endif
-
-#include <avr/boot.h>
+#include <avr/io.h>
 
 #if defined(CHAR_PTR_STRING)
 #include <avr/pgmspace.h>
@@ -47,40 +38,33 @@
 #include <Print.h>
 #endif
 
-Signature::signature_t Signature::signature = {};
+SignatureInfo Signature::info;
+
+#ifdef SIGNATURE_EAGER_INIT
+void Signature::READ() { info = SignatureInfo::read(); }
+
+void Signature::EAGER_INIT() {
+  // GCC only supports basic asm in naked functions: C code may need a stack
+  // frame (e.g. for the temporary SignatureInfo returned by read()), which a
+  // naked function does not set up. So READ() must not be inlined and is only
+  // called here. The stack and __zero_reg__ are set up in .init2.
+#ifdef __AVR_HAVE_JMP_CALL__
+  __asm__ volatile("call signature_read");
+#else
+  __asm__ volatile("rcall signature_read");
+#endif
+}
+#else
 bool Signature::INIT_STATUS = false;
 
-/*!
- * @def DEVICE_SIG_BYTE_1
- * @brief Address of first signature byte
- */
-/*!
- * @def DEVICE_SIG_BYTE_2
- * @brief Address of second signature byte
- */
-/*!
- * @def DEVICE_SIG_BYTE_3
- * @brief Address of third signature byte
- */
 void Signature::INIT() {
-#define DEVICE_SIG_BYTE_1 0x00
-#define DEVICE_SIG_BYTE_2 0x02
-#define DEVICE_SIG_BYTE_3 0x04
-
   if (!INIT_STATUS) {
-    Features::INIT();
-
-    signature.sig1 = boot_signature_byte_get(DEVICE_SIG_BYTE_1);
-    signature.sig2 = boot_signature_byte_get(DEVICE_SIG_BYTE_2);
-    signature.sig3 = boot_signature_byte_get(DEVICE_SIG_BYTE_3);
+    info = SignatureInfo::read();
 
     INIT_STATUS = true;
   }
-
-#undef DEVICE_SIG_BYTE_3
-#undef DEVICE_SIG_BYTE_2
-#undef DEVICE_SIG_BYTE_1
 }
+#endif
 
 String Signature::getSignatureString() {
   String sigStr = F("");
@@ -92,7 +76,7 @@ String Signature::getSignatureString() {
   sigStr += sigStrBegin;
 #endif
 
-  if (signature.sig1 < 16) {
+  if (info.getSignatureByte1() < 16) {
 #if defined(CHAR_PTR_STRING)
     size += strlen((char *)leadingZero);
 #else
@@ -100,12 +84,12 @@ String Signature::getSignatureString() {
 #endif
   }
 #if defined(CHAR_PTR_STRING)
-  size += snprintf(nullptr, 0, "%X", signature.sig1);
+  size += snprintf(nullptr, 0, "%X", info.getSignatureByte1());
 #else
-  sigStr += String(signature.sig1, HEX);
+  sigStr += String(info.getSignatureByte1(), HEX);
 #endif
 
-  if (signature.sig2 < 16) {
+  if (info.getSignatureByte2() < 16) {
 #if defined(CHAR_PTR_STRING)
     size += strlen((char *)leadingZero);
 #else
@@ -113,12 +97,12 @@ String Signature::getSignatureString() {
 #endif
   }
 #if defined(CHAR_PTR_STRING)
-  size += snprintf(nullptr, 0, "%X", signature.sig2);
+  size += snprintf(nullptr, 0, "%X", info.getSignatureByte2());
 #else
-  sigStr += String(signature.sig2, HEX);
+  sigStr += String(info.getSignatureByte2(), HEX);
 #endif
 
-  if (signature.sig3 < 16) {
+  if (info.getSignatureByte3() < 16) {
 #if defined(CHAR_PTR_STRING)
     size += strlen((char *)leadingZero);
 #else
@@ -126,26 +110,26 @@ String Signature::getSignatureString() {
 #endif
   }
 #if defined(CHAR_PTR_STRING)
-  size += snprintf(nullptr, 0, "%X", signature.sig3);
+  size += snprintf(nullptr, 0, "%X", info.getSignatureByte3());
 #else
-  sigStr += String(signature.sig3, HEX);
+  sigStr += String(info.getSignatureByte3(), HEX);
 #endif
 
 #if defined(CHAR_PTR_STRING)
   sigStr = (String)malloc(sizeof(unsigned char) * size + 1);
   sprintf((char *)sigStr, "%s", sigStrBegin);
-  if (signature.sig1 < 16) {
+  if (info.getSignatureByte1() < 16) {
     sprintf((char *)sigStr, "%s%s", sigStr, leadingZero);
   }
-  sprintf((char *)sigStr, "%s%X", sigStr, signature.sig1);
-  if (signature.sig2 < 16) {
+  sprintf((char *)sigStr, "%s%X", sigStr, info.getSignatureByte1());
+  if (info.getSignatureByte2() < 16) {
     sprintf((char *)sigStr, "%s%s", sigStr, leadingZero);
   }
-  sprintf((char *)sigStr, "%s%X", sigStr, signature.sig2);
-  if (signature.sig3 < 16) {
+  sprintf((char *)sigStr, "%s%X", sigStr, info.getSignatureByte2());
+  if (info.getSignatureByte3() < 16) {
     sprintf((char *)sigStr, "%s%s", sigStr, leadingZero);
   }
-  sprintf((char *)sigStr, "%s%X", sigStr, signature.sig3);
+  sprintf((char *)sigStr, "%s%X", sigStr, info.getSignatureByte3());
 #endif
   return sigStr;
 }
@@ -156,10 +140,9 @@ String Signature::getSummary() {
 #if defined(CHAR_PTR_STRING)
   String chipName = getChipName();
   String signatureString = getSignatureString();
-  String featuresSummary = Features::getSummary();
+  String featuresSummary = Features::getSummary(info);
   size_t size = snprintf(nullptr, 0,
-                         "Signature Information:\n"
-                         "\tBoard: "
+                         SIGNATURE_SUMMARY_TITLE
                          "%s"
                          " ("
                          "%s"
@@ -168,8 +151,7 @@ String Signature::getSummary() {
                          chipName, signatureString, featuresSummary);
   auto summary = (String)malloc(sizeof(unsigned char) * size + 1);
   sprintf((char *)summary,
-          "Signature Information:\n"
-          "\tBoard: "
+          SIGNATURE_SUMMARY_TITLE
           "%s"
           " ("
           "%s"
@@ -180,41 +162,80 @@ String Signature::getSummary() {
   free(featuresSummary);
 #else
 
-  String summary = F("Signature Information:\n");
-  summary += F("\tBoard: ");
+  String summary = F(SIGNATURE_SUMMARY_TITLE);
   summary += getChipName();
   summary += F(" (");
   summary += getSignatureString();
   summary += F(")");
-  summary += Features::getSummary();
+  summary += Features::getSummary(info);
 #endif
   return summary;
 }
 
+/*!
+ * @def IS_TARGET
+ * @brief Constant expression, which is true if the library is compiled for the
+ *        device with the given name, i.e. __AVR_<name>__ is defined as 1 (like
+ *        the compiler does for -mmcu).
+ */
+#define IS_TARGET(name) IS_TARGET_VALUE(__AVR_##name##__)
+#define IS_TARGET_VALUE(value) IS_TARGET_PASTE(value)
+#define IS_TARGET_PASTE(value) IS_TARGET_PLACEHOLDER(IS_TARGET_##value)
+#define IS_TARGET_1 0,
+#define IS_TARGET_PLACEHOLDER(placeholder) IS_TARGET_SECOND(placeholder 1, 0)
+#define IS_TARGET_SECOND(ignored, value, ...) value
+
+/*!
+ * @def LAYOUT_ID
+ * @brief Number of a calibration layout of Devices.hpp.
+ */
+#define LAYOUT_ID(layout) LAYOUT_ID_EXPANDED(layout)
+#define LAYOUT_ID_EXPANDED(layout) layout##_ID
+
+/** Numbers of the calibration layouts. */
+enum LayoutId : uint8_t {
+#define LAYOUT(layout) LAYOUT_ID(SIGNATURE_LAYOUT_##layout),
+  SIGNATURE_LAYOUTS(LAYOUT)
+#undef LAYOUT
+};
+
+/** Calibration layout of every device, used for the layout of the aliases. */
+#define DEVICE(name, sig1, sig2, sig3, flashSize, ramSize, layout)             \
+  static constexpr LayoutId name##_LAYOUT =                                    \
+      LAYOUT_ID(SIGNATURE_LAYOUT_##layout);
+SIGNATURE_DEVICES(DEVICE)
+#undef DEVICE
+
+/*
+ * The FEATURE_* macros (and therefore SignatureInfo) have to describe the same
+ * calibration bytes as the entry of the target in Devices.hpp, which is used
+ * by the host tools.
+ */
+#define DEVICE(name, sig1, sig2, sig3, flashSize, ramSize, layout)             \
+  (IS_TARGET(name) && name##_LAYOUT != LAYOUT_ID(FEATURE_LAYOUT)) ||
+#define ALIAS(name, device)                                                    \
+  (IS_TARGET(name) && device##_LAYOUT != LAYOUT_ID(FEATURE_LAYOUT)) ||
+static_assert(!(SIGNATURE_DEVICES(DEVICE) SIGNATURE_ALIASES(ALIAS) false),
+              "FEATURE_LAYOUT does not match the layout in Devices.hpp");
+#undef ALIAS
+#undef DEVICE
+
+/*!
+ * @def CHIP_NAME
+ * @brief Select the name of the device, which the library is compiled for
+ *        (see IS_TARGET). The conditions are constant, so only the matching
+ *        name is kept.
+ * @def ALIAS_NAME
+ * @brief Like CHIP_NAME for the devices of SIGNATURE_ALIASES.
+ */
 String Signature::getChipName() {
-  return
-#if defined(__AVR_ATmega48A__)
-      F("ATmega48A")
-#elif defined(__AVR_ATmega48PA__)
-      F("ATmega48PA")
-#elif defined(__AVR_ATmega88A__)
-      F("ATmega88A")
-#elif defined(__AVR_ATmega88PA__)
-      F("ATmega88PA")
-#elif defined(__AVR_ATmega168A__)
-      F("ATmega168A")
-#elif defined(__AVR_ATmega168PA__)
-      F("ATmega168PA")
-#elif defined(__AVR_ATmega328__)
-      F("ATmega328")
-#elif defined(__AVR_ATmega328P__)
-      F("ATmega328P")
-#elif defined(__AVR_ATmega328PB__)
-      F("ATmega328PB")
-#elif defined(__AVR_ATtiny828__)
-      F("ATtiny828")
-#else
-      F("UNKNOWN")
-#endif
-          ;
+#define CHIP_NAME(name, sig1, sig2, sig3, flashSize, ramSize, layout)          \
+  IS_TARGET(name) ? F(#name) :
+#define ALIAS_NAME(name, device) IS_TARGET(name) ? F(#name) :
+
+  return SIGNATURE_DEVICES(CHIP_NAME) SIGNATURE_ALIASES(ALIAS_NAME)
+      F("UNKNOWN");
+
+#undef ALIAS_NAME
+#undef CHIP_NAME
 }
@@ -43,26 +43,57 @@
 #ifndef SIGNATURE_SIGNATURE_HPP
 #define SIGNATURE_SIGNATURE_HPP
 
-#include "Features.hpp"
+#include "SignatureInfo.hpp"
+
+/*!
+ * @def SIGNATURE_EAGER_INIT
+ * @brief Opt-in: Read the signature row in the .init8 section, i.e. before
+ *        main() and before interrupts are enabled. All getters are then plain
+ *        loads without an initialisation check.
+ *
+ * @note  Has to be defined for the whole build (e.g. with build flags), so
+ *        that the library and the sketch see the same definition. Otherwise
+ *        linking fails with an undefined reference to signature_info_eager
+ *        or Signature::info. Constructors of global objects run before .init8
+ *        and must not use the getters.
+ */
 
 /*!
  * @brief   Class representing the signature of the microcontroller.
  */
 class Signature {
 private:
-  /** structure of signature */
-  typedef struct {
-    uint8_t sig1, sig2, sig3; /// The bytes of the signature.
-  } signature_t;
+#ifdef SIGNATURE_EAGER_INIT
+  // Own assembler name, so that code compiled with a different setting than
+  // Signature.cpp does not link (instead of reading a snapshot never filled).
+  static SignatureInfo info __asm__("signature_info_eager"); /// Snapshot.
 
-  static signature_t signature; /// Signature of AVR microcontroller.
+  /*!
+   * @brief Read the signature row. Called from EAGER_INIT() only, by its
+   *        assembler name.
+   */
+  static void READ() __asm__("signature_read")
+      __attribute__((noinline, used, externally_visible));
 
-  static bool INIT_STATUS; /// Indicating if the class is initialized.
+  /*!
+   * @brief Entry point in the .init8 section, which is executed before main().
+   */
+  static void EAGER_INIT() __attribute__((naked, used, section(".init8")));
+
+  /*!
+   * @brief Initialise the class. Nothing to do, the signature row has already
+   *        been read by EAGER_INIT().
+   */
+  static void INIT() {}
+#else
+  static SignatureInfo info; /// Snapshot of the signature row.
+  static bool INIT_STATUS;   /// Indicating if the class is initialized.
 
   /*!
    * @brief Initialise the class.
    */
   static void INIT();
+#endif
 
   /*!
    * @brief Get the signature as a string.
@@ -75,6 +106,18 @@ private:
   static String getSignatureString();
 
 public:
+  /*!
+   * @brief Get a snapshot of the signature row. The snapshot is read only once
+   *        and can be kept by the caller, so further reads of its fields do
+   *        not need any initialisation check.
+   *
+   * @return    The snapshot of the signature row.
+   */
+  static SignatureInfo getInfo() {
+    INIT();
+    return info;
+  }
+
   /*!
    * @brief Get the signature as a string.
    *
@@ -95,6 +138,40 @@ public:
    */
   static String getChipName();
 
+  /*!
+   * @brief Check at compile time, if a feature is available. Can be used in
+   *        constant expressions (e.g. static_assert or enable_if), so code for
+   *        unavailable features is removed completely.
+   *
+   * @return    True, if the feature exists on the microcontroller.
+   */
+  template <Feature F> static constexpr bool has() {
+    return SignatureInfo::has<F>();
+  }
+
+  /*!
+   * @brief Get the factory calibration of a feature. Fails to compile, if the
+   *        feature is not available.
+   *
+   * @return    Calibration value as an unsigned char.
+   */
+  template <Feature F> static uint8_t get() {
+    INIT();
+    return info.get<F>();
+  }
+
+  /*!
+   * @brief Get the factory calibration of a feature, or a fallback if the
+   *        feature is not available. Compiles on every microcontroller.
+   *
+   * @param fallback    Value, if the feature is not available.
+   * @return    Calibration value as an unsigned char.
+   */
+  template <Feature F> static uint8_t getOr(uint8_t fallback) {
+    INIT();
+    return info.getOr<F>(fallback);
+  }
+
 #ifdef FEATURE_RC_OSCILLATOR_CALIBRATION
   /*!
    * @brief Get the factory calibration of the internal RC oscillator (OSCCAL).
@@ -103,7 +180,7 @@ public:
    */
   static uint8_t getRcOscillatorCalibration() {
     INIT();
-    return Features::getRcOscillatorCalibration();
+    return info.getRcOscillatorCalibration();
   }
 #endif
 
@@ -116,7 +193,7 @@ public:
    */
   static uint8_t getInternal8MHzOscillatorCalibration() {
     INIT();
-    return Features::getInternal8MHzOscillatorCalibration();
+    return info.getInternal8MHzOscillatorCalibration();
   }
 #endif
 
@@ -129,7 +206,7 @@ public:
    */
   static uint8_t getOscillatorTemperatureCalibrationA() {
     INIT();
-    return Features::getOscillatorTemperatureCalibrationA();
+    return info.getOscillatorTemperatureCalibrationA();
   }
 #endif
 
@@ -141,7 +218,7 @@ public:
    */
   static uint8_t getOscillatorTemperatureCalibrationB() {
     INIT();
-    return Features::getOscillatorTemperatureCalibrationB();
+    return info.getOscillatorTemperatureCalibrationB();
   }
 #endif
 
@@ -154,7 +231,7 @@ public:
    */
   static uint8_t getInternal32kHzOscillatorCalibration() {
     INIT();
-    return Features::getInternal32kHzOscillatorCalibration();
+    return info.getInternal32kHzOscillatorCalibration();
   }
 #endif
 
@@ -166,7 +243,7 @@ public:
    */
   static uint8_t getTemperatureSensorGainCalibration() {
     INIT();
-    return Features::getTemperatureSensorGainCalibration();
+    return info.getTemperatureSensorGainCalibration();
   }
 #endif
 
@@ -178,7 +255,7 @@ public:
    */
   static uint8_t getTemperatureSensorOffsetCalibration() {
     INIT();
-    return Features::getTemperatureSensorOffsetCalibration();
+    return info.getTemperatureSensorOffsetCalibration();
   }
 #endif
 
@@ -0,0 +1,56 @@
+/*!
+ * @file SignatureInfo.cpp
+ *
+ * This file is part of the Signature library. It gives easy access to the
+ * signature of AVR microcontrollers. The library contains functions that
+ * provides the information of the signature bytes.
+ *
+ * Copyright (C) 2022-2023  Niklas Kaaf
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ * USA
+ */
+
+#include "SignatureInfo.hpp"
+#include "Devices.hpp"
+
+// Fix until https://github.com/avrdudes/avr-libc/issues/907 is fixed
+#if defined(__AVR_ATtiny24__) || defined(__AVR_ATtiny25__) ||                  \
+    defined(__AVR_ATtiny44__) || defined(__AVR_ATtiny45__) ||                  \
+    defined(__AVR_ATtiny84__) || defined(__AVR_ATtiny85__) ||                  \
+    defined(__AVR_ATtiny441__) || defined(__AVR_ATtiny828__) ||                \
+    defined(__AVR_ATtiny841__) || defined(__AVR_ATtiny1634__) ||               \
+    defined(__AVR_ATtiny4313__)
+#define SIGRD RSIG
+#endif
+
+#include <avr/boot.h>
+
+SignatureInfo SignatureInfo::read() {
+#define READ_FIELD(index, address, label)                                      \
+  info.bytes[index] = boot_signature_byte_get(address);
+
+  SignatureInfo info;
+  info.bytes[SIGNATURE_BYTE_1] =
+      boot_signature_byte_get(SIGNATURE_BYTE_1_ADDRESS);
+  info.bytes[SIGNATURE_BYTE_2] =
+      boot_signature_byte_get(SIGNATURE_BYTE_2_ADDRESS);
+  info.bytes[SIGNATURE_BYTE_3] =
+      boot_signature_byte_get(SIGNATURE_BYTE_3_ADDRESS);
+  FEATURE_LAYOUT(READ_FIELD)
+  return info;
+
+#undef READ_FIELD
+}
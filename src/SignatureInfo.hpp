@@ -0,0 +1,363 @@
+/*!
+ * @file SignatureInfo.hpp
+ *
+ * This file is part of the Signature library. It gives easy access to the
+ * signature of AVR microcontrollers. The library contains functions that
+ * provides the information of the signature bytes.
+ *
+ * Copyright (C) 2022-2023  Niklas Kaaf
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ * USA
+ */
+
+#ifndef SIGNATURE_SIGNATURE_INFO_HPP
+#define SIGNATURE_SIGNATURE_INFO_HPP
+
+#include "Features.hpp"
+
+/*!
+ * @brief   Compile time properties of a feature.
+ *
+ * AVAILABLE tells if the feature exists on the microcontroller, INDEX is the
+ * position of its byte inside SignatureInfo (0 if not available).
+ */
+template <Feature F> struct FeatureTraits {
+  static constexpr bool AVAILABLE = false; /// Feature exists.
+  static constexpr uint8_t INDEX = 0;      /// Position in SignatureInfo.
+};
+
+/*!
+ * @brief   Immutable snapshot of the signature row of the microcontroller.
+ *
+ * The snapshot only consists of the bytes read from the signature row, so it
+ * is trivially copyable and can be stored, compared or transmitted as it is.
+ * Instances are either read once from the chip with read() or constructed
+ * directly, e.g. with synthetic values on the host.
+ */
+class SignatureInfo {
+public:
+  /** Position of the bytes inside the snapshot. */
+  enum Index : uint8_t {
+    SIGNATURE_BYTE_1, /// First signature byte (manufacturer).
+    SIGNATURE_BYTE_2, /// Second signature byte (flash size).
+    SIGNATURE_BYTE_3, /// Third signature byte (device).
+#ifdef FEATURE_RC_OSCILLATOR_CALIBRATION
+    RC_OSCILLATOR_CALIBRATION, /// OSCCAL factory calibration.
+#endif
+#ifdef FEATURE_INTERNAL_8MHZ_OSCILLATOR_CALIBRATION
+    INTERNAL_8MHZ_OSCILLATOR_CALIBRATION, /// OSCCAL0 factory calibration.
+#endif
+#ifdef FEATURE_OSCILLATOR_TEMPERATURE_CALIBRATION_A
+    OSCILLATOR_TEMPERATURE_CALIBRATION_A, /// OSCTCAL0A factory calibration.
+#endif
+#ifdef FEATURE_OSCILLATOR_TEMPERATURE_CALIBRATION_B
+    OSCILLATOR_TEMPERATURE_CALIBRATION_B, /// OSCTCAL0B factory calibration.
+#endif
+#ifdef FEATURE_INTERNAL_32KHZ_OSCILLATOR_CALIBRATION
+    INTERNAL_32KHZ_OSCILLATOR_CALIBRATION, /// OSCCAL1 factory calibration.
+#endif
+#ifdef FEATURE_TEMPERATURE_SENSOR_GAIN_CALIBRATION
+    TEMPERATURE_SENSOR_GAIN_CALIBRATION, /// Temperature sensor gain.
+#endif
+#ifdef FEATURE_TEMPERATURE_SENSOR_OFFSET_CALIBRATION
+    TEMPERATURE_SENSOR_OFFSET_CALIBRATION, /// Temperature sensor offset.
+#endif
+    SIZE /// Number of bytes in the snapshot.
+  };
+
+private:
+  uint8_t bytes[SIZE]; /// Raw bytes of the snapshot, ordered by Index.
+
+  /*!
+   * @brief Hash the bytes starting at an index (djb2, truncated to 16 bit).
+   */
+  constexpr uint16_t hashFrom(uint8_t index, uint16_t value) const {
+    return index == SIZE ? value
+                         : hashFrom(index + 1, (uint16_t)((value << 5) + value +
+                                                          bytes[index]));
+  }
+
+  /*!
+   * @brief Compare the bytes starting at an index with another snapshot.
+   */
+  constexpr bool equalFrom(uint8_t index, const SignatureInfo &other) const {
+    return index == SIZE || (bytes[index] == other.bytes[index] &&
+                             equalFrom(index + 1, other));
+  }
+
+public:
+  /*!
+   * @brief Construct a snapshot from known values.
+   *
+   * @note  The calibration parameters only exist, if the corresponding
+   *        feature is available on the microcontroller.
+   */
+  constexpr SignatureInfo(uint8_t signatureByte1 = 0,
+                          uint8_t signatureByte2 = 0,
+                          uint8_t signatureByte3 = 0
+#ifdef FEATURE_RC_OSCILLATOR_CALIBRATION
+                          ,
+                          uint8_t rcOscillatorCalibration = 0
+#endif
+#ifdef FEATURE_INTERNAL_8MHZ_OSCILLATOR_CALIBRATION
+                          ,
+                          uint8_t internal8MHzOscillatorCalibration = 0
+#endif
+#ifdef FEATURE_OSCILLATOR_TEMPERATURE_CALIBRATION_A
+                          ,
+                          uint8_t oscillatorTemperatureCalibrationA = 0
+#endif
+#ifdef FEATURE_OSCILLATOR_TEMPERATURE_CALIBRATION_B
+                          ,
+                          uint8_t oscillatorTemperatureCalibrationB = 0
+#endif
+#ifdef FEATURE_INTERNAL_32KHZ_OSCILLATOR_CALIBRATION
+                          ,
+                          uint8_t internal32kHzOscillatorCalibration = 0
+#endif
+#ifdef FEATURE_TEMPERATURE_SENSOR_GAIN_CALIBRATION
+                          ,
+                          uint8_t temperatureSensorGainCalibration = 0
+#endif
+#ifdef FEATURE_TEMPERATURE_SENSOR_OFFSET_CALIBRATION
+                          ,
+                          uint8_t temperatureSensorOffsetCalibration = 0
+#endif
+                          )
+      : bytes{signatureByte1, signatureByte2, signatureByte3
+#ifdef FEATURE_RC_OSCILLATOR_CALIBRATION
+              ,
+              rcOscillatorCalibration
+#endif
+#ifdef FEATURE_INTERNAL_8MHZ_OSCILLATOR_CALIBRATION
+              ,
+              internal8MHzOscillatorCalibration
+#endif
+#ifdef FEATURE_OSCILLATOR_TEMPERATURE_CALIBRATION_A
+              ,
+              oscillatorTemperatureCalibrationA
+#endif
+#ifdef FEATURE_OSCILLATOR_TEMPERATURE_CALIBRATION_B
+              ,
+              oscillatorTemperatureCalibrationB
+#endif
+#ifdef FEATURE_INTERNAL_32KHZ_OSCILLATOR_CALIBRATION
+              ,
+              internal32kHzOscillatorCalibration
+#endif
+#ifdef FEATURE_TEMPERATURE_SENSOR_GAIN_CALIBRATION
+              ,
+              temperatureSensorGainCalibration
+#endif
+#ifdef FEATURE_TEMPERATURE_SENSOR_OFFSET_CALIBRATION
+              ,
+              temperatureSensorOffsetCalibration
+#endif
+        } {
+  }
+
+  /*!
+   * @brief Read the snapshot from the signature row of the microcontroller.
+   *
+   * @return    The snapshot of the running microcontroller.
+   */
+  static SignatureInfo read();
+
+  /*!
+   * @brief Get a byte of the snapshot.
+   *
+   * @param index   Position of the byte.
+   * @return    The byte at the position.
+   */
+  constexpr uint8_t getByte(uint8_t index) const { return bytes[index]; }
+
+  /*!
+   * @brief Get the raw bytes of the snapshot, e.g. for storing or sending it.
+   *
+   * @return    Pointer to SIZE bytes ordered by Index.
+   */
+  const uint8_t *getBytes() const { return bytes; }
+
+  /*!
+   * @brief Get the signature as a 24-bit value (e.g. 0x1E950F).
+   *
+   * @return    The three signature bytes, first byte most significant.
+   */
+  constexpr uint32_t getSignature() const {
+    return (uint32_t)bytes[SIGNATURE_BYTE_1] << 16 |
+           (uint32_t)bytes[SIGNATURE_BYTE_2] << 8 | bytes[SIGNATURE_BYTE_3];
+  }
+
+  constexpr uint8_t getSignatureByte1() const {
+    return bytes[SIGNATURE_BYTE_1];
+  }
+
+  constexpr uint8_t getSignatureByte2() const {
+    return bytes[SIGNATURE_BYTE_2];
+  }
+
+  constexpr uint8_t getSignatureByte3() const {
+    return bytes[SIGNATURE_BYTE_3];
+  }
+
+#ifdef FEATURE_RC_OSCILLATOR_CALIBRATION
+  constexpr uint8_t getRcOscillatorCalibration() const {
+    return bytes[RC_OSCILLATOR_CALIBRATION];
+  }
+#endif
+
+#ifdef FEATURE_INTERNAL_8MHZ_OSCILLATOR_CALIBRATION
+  constexpr uint8_t getInternal8MHzOscillatorCalibration() const {
+    return bytes[INTERNAL_8MHZ_OSCILLATOR_CALIBRATION];
+  }
+#endif
+
+#ifdef FEATURE_OSCILLATOR_TEMPERATURE_CALIBRATION_A
+  constexpr uint8_t getOscillatorTemperatureCalibrationA() const {
+    return bytes[OSCILLATOR_TEMPERATURE_CALIBRATION_A];
+  }
+#endif
+
+#ifdef FEATURE_OSCILLATOR_TEMPERATURE_CALIBRATION_B
+  constexpr uint8_t getOscillatorTemperatureCalibrationB() const {
+    return bytes[OSCILLATOR_TEMPERATURE_CALIBRATION_B];
+  }
+#endif
+
+#ifdef FEATURE_INTERNAL_32KHZ_OSCILLATOR_CALIBRATION
+  constexpr uint8_t getInternal32kHzOscillatorCalibration() const {
+    return bytes[INTERNAL_32KHZ_OSCILLATOR_CALIBRATION];
+  }
+#endif
+
+#ifdef FEATURE_TEMPERATURE_SENSOR_GAIN_CALIBRATION
+  constexpr uint8_t getTemperatureSensorGainCalibration() const {
+    return bytes[TEMPERATURE_SENSOR_GAIN_CALIBRATION];
+  }
+#endif
+
+#ifdef FEATURE_TEMPERATURE_SENSOR_OFFSET_CALIBRATION
+  constexpr uint8_t getTemperatureSensorOffsetCalibration() const {
+    return bytes[TEMPERATURE_SENSOR_OFFSET_CALIBRATION];
+  }
+#endif
+
+  /*!
+   * @brief Check at compile time, if a feature is available.
+   *
+   * @return    True, if the feature exists on the microcontroller.
+   */
+  template <Feature F> static constexpr bool has() {
+    return FeatureTraits<F>::AVAILABLE;
+  }
+
+  /*!
+   * @brief Get the byte of a feature. Fails to compile, if the feature is not
+   *        available.
+   *
+   * @return    Calibration value as an unsigned char.
+   */
+  template <Feature F> constexpr uint8_t get() const {
+    static_assert(FeatureTraits<F>::AVAILABLE,
+                  "Feature is not available on this microcontroller");
+    return bytes[FeatureTraits<F>::INDEX];
+  }
+
+  /*!
+   * @brief Get the byte of a feature, or a fallback if the feature is not
+   *        available. Compiles on every microcontroller, so it can be used in
+   *        portable code together with has().
+   *
+   * @param fallback    Value, if the feature is not available.
+   * @return    Calibration value as an unsigned char.
+   */
+  template <Feature F> constexpr uint8_t getOr(uint8_t fallback) const {
+    return FeatureTraits<F>::AVAILABLE ? bytes[FeatureTraits<F>::INDEX]
+                                       : fallback;
+  }
+
+  /*!
+   * @brief Get a 16-bit hash of all bytes of the snapshot.
+   *
+   * @return    The hash value.
+   */
+  constexpr uint16_t hash() const { return hashFrom(0, 5381); }
+
+  constexpr bool operator==(const SignatureInfo &other) const {
+    return equalFrom(0, other);
+  }
+
+  constexpr bool operator!=(const SignatureInfo &other) const {
+    return !equalFrom(0, other);
+  }
+};
+
+#ifdef FEATURE_RC_OSCILLATOR_CALIBRATION
+template <> struct FeatureTraits<Feature::RcOscillatorCalibration> {
+  static constexpr bool AVAILABLE = true;
+  static constexpr uint8_t INDEX = SignatureInfo::RC_OSCILLATOR_CALIBRATION;
+};
+#endif
+
+#ifdef FEATURE_INTERNAL_8MHZ_OSCILLATOR_CALIBRATION
+template <> struct FeatureTraits<Feature::Internal8MHzOscillatorCalibration> {
+  static constexpr bool AVAILABLE = true;
+  static constexpr uint8_t INDEX =
+      SignatureInfo::INTERNAL_8MHZ_OSCILLATOR_CALIBRATION;
+};
+#endif
+
+#ifdef FEATURE_OSCILLATOR_TEMPERATURE_CALIBRATION_A
+template <> struct FeatureTraits<Feature::OscillatorTemperatureCalibrationA> {
+  static constexpr bool AVAILABLE = true;
+  static constexpr uint8_t INDEX =
+      SignatureInfo::OSCILLATOR_TEMPERATURE_CALIBRATION_A;
+};
+#endif
+
+#ifdef FEATURE_OSCILLATOR_TEMPERATURE_CALIBRATION_B
+template <> struct FeatureTraits<Feature::OscillatorTemperatureCalibrationB> {
+  static constexpr bool AVAILABLE = true;
+  static constexpr uint8_t INDEX =
+      SignatureInfo::OSCILLATOR_TEMPERATURE_CALIBRATION_B;
+};
+#endif
+
+#ifdef FEATURE_INTERNAL_32KHZ_OSCILLATOR_CALIBRATION
+template <> struct FeatureTraits<Feature::Internal32kHzOscillatorCalibration> {
+  static constexpr bool AVAILABLE = true;
+  static constexpr uint8_t INDEX =
+      SignatureInfo::INTERNAL_32KHZ_OSCILLATOR_CALIBRATION;
+};
+#endif
+
+#ifdef FEATURE_TEMPERATURE_SENSOR_GAIN_CALIBRATION
+template <> struct FeatureTraits<Feature::TemperatureSensorGainCalibration> {
+  static constexpr bool AVAILABLE = true;
+  static constexpr uint8_t INDEX =
+      SignatureInfo::TEMPERATURE_SENSOR_GAIN_CALIBRATION;
+};
+#endif
+
+#ifdef FEATURE_TEMPERATURE_SENSOR_OFFSET_CALIBRATION
+template <> struct FeatureTraits<Feature::TemperatureSensorOffsetCalibration> {
+  static constexpr bool AVAILABLE = true;
+  static constexpr uint8_t INDEX =
+      SignatureInfo::TEMPERATURE_SENSOR_OFFSET_CALIBRATION;
+};
+#endif
+
+#endif // SIGNATURE_SIGNATURE_INFO_HPP
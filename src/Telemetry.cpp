@@ -0,0 +1,135 @@
+/*!
+ * @file Telemetry.cpp
+ *
+ * This file is part of the Signature library. It gives easy access to the
+ * signature of AVR microcontrollers. The library contains functions that
+ * provides the information of the signature bytes.
+ *
+ * Copyright (C) 2022-2023  Niklas Kaaf
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ * USA
+ */
+
+#include "Telemetry.hpp"
+#include "Signature.hpp"
+
+#include <avr/boot.h>
+#include <avr/eeprom.h>
+#include <string.h>
+#include <util/crc16.h>
+
+/*!
+ * @def RECORD_VERSION
+ * @brief Offset of the version in the EEPROM record
+ */
+#define RECORD_VERSION 0
+/*!
+ * @def RECORD_CRC
+ * @brief Offset of the CRC (little endian) in the EEPROM record
+ */
+#define RECORD_CRC 1
+/*!
+ * @def RECORD_SNAPSHOT
+ * @brief Offset of the snapshot in the EEPROM record
+ */
+#define RECORD_SNAPSHOT 3
+
+uint8_t Telemetry::report(uint8_t *buffer, uint16_t address) {
+  uint8_t record[RECORD_SIZE];
+  build(record);
+
+  uint8_t stored[RECORD_SIZE];
+  eeprom_read_block(stored, (const void *)address, RECORD_SNAPSHOT);
+  if (stored[RECORD_VERSION] == VERSION &&
+      memcmp(stored, record, RECORD_SNAPSHOT) == 0) {
+    buffer[0] = UNCHANGED | VERSION;
+    buffer[1] = 0;
+    return 2;
+  }
+
+  // The stored snapshot is only a base for the diff if it is complete.
+  bool known = false;
+  if (stored[RECORD_VERSION] == VERSION) {
+    eeprom_read_block(stored + RECORD_SNAPSHOT,
+                      (const void *)(address + RECORD_SNAPSHOT), SIZE);
+    uint16_t checksum = crc(stored + RECORD_SNAPSHOT);
+    known = stored[RECORD_CRC] == (checksum & 0xFF) &&
+            stored[RECORD_CRC + 1] == (checksum >> 8);
+  }
+  return diff(known ? stored + RECORD_SNAPSHOT : nullptr,
+              record + RECORD_SNAPSHOT, buffer);
+}
+
+void Telemetry::acknowledge(uint16_t address) {
+  uint8_t record[RECORD_SIZE];
+  build(record);
+
+  uint8_t stored[RECORD_SIZE];
+  eeprom_read_block(stored, (const void *)address, RECORD_SIZE);
+  if (memcmp(stored, record, RECORD_SIZE) == 0) {
+    return;
+  }
+
+  // Invalidate the record first and validate it last (see Telemetry).
+  eeprom_update_byte((uint8_t *)(address + RECORD_VERSION), (uint8_t)~VERSION);
+  eeprom_update_block(record + RECORD_CRC, (void *)(address + RECORD_CRC),
+                      RECORD_SIZE - RECORD_CRC);
+  eeprom_update_byte((uint8_t *)(address + RECORD_VERSION), VERSION);
+}
+
+void Telemetry::build(uint8_t *record) {
+  uint8_t *snapshot = record + RECORD_SNAPSHOT;
+  read(snapshot);
+  uint16_t checksum = crc(snapshot);
+  record[RECORD_VERSION] = VERSION;
+  record[RECORD_CRC] = checksum & 0xFF;
+  record[RECORD_CRC + 1] = checksum >> 8;
+}
+
+#undef RECORD_SNAPSHOT
+#undef RECORD_CRC
+#undef RECORD_VERSION
+
+void Telemetry::read(uint8_t *snapshot) {
+  SignatureInfo info = Signature::getInfo();
+  memcpy(snapshot, info.getBytes(), SignatureInfo::SIZE);
+  snapshot[LOW_FUSE] = boot_lock_fuse_bits_get(GET_LOW_FUSE_BITS);
+  snapshot[HIGH_FUSE] = boot_lock_fuse_bits_get(GET_HIGH_FUSE_BITS);
+  snapshot[EXTENDED_FUSE] = boot_lock_fuse_bits_get(GET_EXTENDED_FUSE_BITS);
+  snapshot[LOCK_BITS] = boot_lock_fuse_bits_get(GET_LOCK_BITS);
+}
+
+uint8_t Telemetry::diff(const uint8_t *previous, const uint8_t *current,
+                        uint8_t *buffer) {
+  uint8_t size = 2;
+  for (uint8_t index = 0; index < SIZE; ++index) {
+    if (previous == nullptr || previous[index] != current[index]) {
+      buffer[size++] = index;
+      buffer[size++] = current[index];
+    }
+  }
+  buffer[0] = (size == 2 ? UNCHANGED : CHANGED) | VERSION;
+  buffer[1] = (size - 2) / 2;
+  return size;
+}
+
+uint16_t Telemetry::crc(const uint8_t *snapshot) {
+  uint16_t value = 0xFFFF;
+  for (uint8_t index = 0; index < SIZE; ++index) {
+    value = _crc_ccitt_update(value, snapshot[index]);
+  }
+  return value;
+}
@@ -0,0 +1,130 @@
+/*!
+ * @file Telemetry.hpp
+ *
+ * This file is part of the Signature library. It gives easy access to the
+ * signature of AVR microcontrollers. The library contains functions that
+ * provides the information of the signature bytes.
+ *
+ * Copyright (C) 2022-2023  Niklas Kaaf
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ * USA
+ */
+
+#ifndef SIGNATURE_TELEMETRY_HPP
+#define SIGNATURE_TELEMETRY_HPP
+
+#include "SignatureInfo.hpp"
+
+/*!
+ * @brief   Class reporting only the changes of the signature row and the fuses
+ *          since the last report.
+ *
+ * The last reported snapshot is kept in the EEPROM together with a version and
+ * a CRC. A report is either the 2-byte token "unchanged" or the list of
+ * changed fields:
+ *
+ *    [header] [count] ([index] [value]) * count
+ *
+ * The header is the type (UNCHANGED or CHANGED) combined with VERSION, the
+ * index is the position in the snapshot (SignatureInfo::Index, followed by
+ * the fuses).
+ *
+ * report() does not write the EEPROM: the sketch calls acknowledge() once the
+ * report has been delivered, so a lost report is sent again on the next boot.
+ * acknowledge() only writes if something changed, and then only the changed
+ * bytes. The version is invalidated first and written last, so a reset while
+ * writing leaves a record that is not accepted (the next report is a full
+ * one) instead of a wrong base for the next diff.
+ */
+class Telemetry {
+public:
+  /** Position of the fuses in the snapshot, following the SignatureInfo. */
+  enum Index : uint8_t {
+    LOW_FUSE = SignatureInfo::SIZE, /// Low fuse byte.
+    HIGH_FUSE,                      /// High fuse byte.
+    EXTENDED_FUSE,                  /// Extended fuse byte.
+    LOCK_BITS,                      /// Lock bits.
+    SIZE                            /// Number of bytes in the snapshot.
+  };
+
+  /** Type of a report, stored in the upper nibble of the header. */
+  enum Type : uint8_t {
+    UNCHANGED = 0x00, /// Nothing changed since the last report.
+    CHANGED = 0x10    /// The changed fields follow.
+  };
+
+  static constexpr uint8_t VERSION = 1; /// Format of report and EEPROM record.
+
+  /** Number of bytes the EEPROM record needs (version, CRC, snapshot). */
+  static constexpr uint8_t RECORD_SIZE = 3 + SIZE;
+
+  /** Maximal number of bytes of a report. */
+  static constexpr uint8_t MAX_REPORT_SIZE = 2 + 2 * SIZE;
+
+  /*!
+   * @brief Compare the current snapshot with the one in the EEPROM and write
+   *        the report. The EEPROM is not written (see acknowledge()).
+   *
+   * @param buffer  Output, receives the report (at least MAX_REPORT_SIZE).
+   * @param address EEPROM address of the record (RECORD_SIZE bytes).
+   * @return    Number of bytes of the report.
+   */
+  static uint8_t report(uint8_t *buffer, uint16_t address);
+
+  /*!
+   * @brief Store the current snapshot in the EEPROM, after its report has
+   *        been delivered. Nothing is written if it is stored already.
+   *
+   * @param address EEPROM address of the record (RECORD_SIZE bytes).
+   */
+  static void acknowledge(uint16_t address);
+
+  /*!
+   * @brief Read the current snapshot of the signature row and the fuses.
+   *
+   * @param snapshot    Output, receives SIZE bytes.
+   */
+  static void read(uint8_t *snapshot);
+
+  /*!
+   * @brief Write the report of the changes between two snapshots.
+   *
+   * @param previous    Last reported snapshot, or nullptr if unknown.
+   * @param current     Current snapshot.
+   * @param buffer      Output, receives the report (at least MAX_REPORT_SIZE).
+   * @return    Number of bytes of the report.
+   */
+  static uint8_t diff(const uint8_t *previous, const uint8_t *current,
+                      uint8_t *buffer);
+
+  /*!
+   * @brief Compute the CRC (CCITT) of a snapshot.
+   *
+   * @param snapshot    Snapshot of SIZE bytes.
+   * @return    The CRC.
+   */
+  static uint16_t crc(const uint8_t *snapshot);
+
+private:
+  /*!
+   * @brief Build the EEPROM record of the current snapshot.
+   *
+   * @param record  Output, receives RECORD_SIZE bytes.
+   */
+  static void build(uint8_t *record);
+};
+
+#endif // SIGNATURE_TELEMETRY_HPP